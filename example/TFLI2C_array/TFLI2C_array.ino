@@ -0,0 +1,55 @@
+/* File Name: TFLI2C_array.ino
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0
+ * Described: Arduino example sketch for several Benewake TF-Luna
+ *            LiDAR sensors sharing one I2C bus at different addresses.
+ *            Each device must first be given its own address with
+ *            `Set_I2C_Addr`, `Save_Settings` and `Soft_Reset`.
+ */
+
+#include <Arduino.h>     // every sketch needs this
+#include <Wire.h>        // instantiate the Wire library
+#include <TFLI2C.h>      // TFLuna-I2C Library v.0.3.0
+#include <TFLI2CArray.h>
+
+TFLI2C tflI2C;
+TFLI2CArray tflArray( tflI2C);
+
+// Insert the addresses of your own devices
+uint8_t tfAddr[] = { 0x10, 0x11, 0x12};
+
+int16_t  tfDist;    // distance in centimeters
+int16_t  tfFlux;    // signal quality in arbitrary units
+int16_t  tfTemp;    // temperature in 0.01 degree Celsius
+
+void setup()
+{
+    Serial.begin( 115200);  // initialize serial port
+    Wire.begin();           // initialize Wire library
+    tflI2C.Set_Bus( &Wire);
+    Serial.println( "TFLI2C array example code"); // say "Hello!"
+    Serial.println( "14 OCT 2026");               // and add date
+
+    for( uint8_t i = 0; i < sizeof( tfAddr); ++i)
+    {
+      tflArray.addDevice( tfAddr[ i]);
+    }
+    Serial.print( "Devices online: ");
+    Serial.println( tflArray.begin());
+}
+
+void loop()
+{
+    // Read whichever device is due next
+    int8_t i = tflArray.update();
+    if( i < 0) return;                   // nothing due yet
+
+    if( tflArray.getData( i, tfDist, tfFlux, tfTemp))
+    {
+        Serial.print( "Addr: ");
+        Serial.print( tflArray.device( i).addr, HEX);
+        Serial.print( " | Dist: ");
+        Serial.println( tfDist);
+    }
+}
@@ -0,0 +1,253 @@
+/* File Name: TFLI2C_benchmark.ino
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0
+ * Described: Benchmark sketch for the Benewake TF-Luna LiDAR sensor
+ *            configured for the I2C interface.
+ *
+ *  For every device frame rate in `fpsList` and every Wire clock in
+ *  `clkList`, each read strategy is run for `RUN_MS` milliseconds:
+ *    BYTE  - eight single register `readReg` calls per frame
+ *    BURST - one `getFreshData` burst read per frame
+ *    ASYNC - `startRead` and `poll` per frame
+ *    ARRAY - `TFLI2CArray` scheduling every device in `tfAddr`
+ *
+ *  One line of comma separated values is printed for each run:
+ *    strategy, clock Hz, device fps, reads, new frames per second,
+ *    read latency 50th, 90th, 99th percentile and maximum in
+ *    microseconds, and percent of the run time spent on the bus.
+ *
+ *  "New frames" are frames with a new device tick, so the frames per
+ *  second column shows how much of the device frame rate reached the
+ *  sketch.  Latency percentiles are taken from the first `LAT_N`
+ *  reads of each run.  Paste the output into a spreadsheet to compare
+ *  boards, configurations or library versions.
+ *
+ *  The frame rate of every device is changed but not saved, so a
+ *  power cycle restores the previous setting.
+ */
+
+#include <Arduino.h>     // every sketch needs this
+#include <Wire.h>        // instantiate the Wire library
+#include <TFLI2C.h>      // TFLuna-I2C Library v.0.3.0
+#include <TFLI2CArray.h>
+
+TFLI2C tflI2C;
+TFLI2CArray tflArray( tflI2C);
+
+// Insert the addresses of your own devices.
+// The single device strategies use the first one.
+uint8_t tfAddr[] = { TFL_DEF_ADR};
+
+uint16_t fpsList[] = { FPS_35, FPS_50, FPS_100, FPS_125, FPS_250};
+uint32_t clkList[] = { 100000UL, 400000UL, 1000000UL};
+
+#define RUN_MS     2000   // length of each run in milliseconds
+#define LAT_N       128   // latency samples kept for percentiles
+
+uint16_t latency[ LAT_N];  // read latencies of the current run
+uint16_t latCount;
+uint32_t reads;            // reads completed in the current run
+uint32_t fresh;            // reads with a new device tick
+uint32_t busTime;          // microseconds spent reading
+uint16_t lastTick;
+
+void startRun()
+{
+    latCount = 0;
+    reads = 0;
+    fresh = 0;
+    busTime = 0;
+    lastTick = 0;
+}
+
+// Record one read that took `us` microseconds
+void addRead( uint32_t us, bool isNew)
+{
+    if( latCount < LAT_N) latency[ latCount++] = ( us > 0xFFFF) ? 0xFFFF : us;
+    busTime += us;
+    ++reads;
+    if( isNew) ++fresh;
+}
+
+// Insertion sort, then pick the percentile
+uint16_t percentile( uint8_t pct)
+{
+    if( latCount == 0) return 0;
+    uint16_t i = ( uint32_t)( latCount - 1) * pct / 100;
+    return latency[ i];
+}
+
+void sortLatency()
+{
+    for( uint16_t i = 1; i < latCount; ++i)
+    {
+      uint16_t v = latency[ i];
+      uint16_t j = i;
+      while( j > 0 && latency[ j - 1] > v)
+      {
+        latency[ j] = latency[ j - 1];
+        --j;
+      }
+      latency[ j] = v;
+    }
+}
+
+void printRun( const char *name, uint32_t clk, uint16_t fps, uint32_t elapsed)
+{
+    sortLatency();
+    Serial.print( name);
+    Serial.print( ",");
+    Serial.print( clk);
+    Serial.print( ",");
+    Serial.print( fps);
+    Serial.print( ",");
+    Serial.print( reads);
+    Serial.print( ",");
+    Serial.print( ( float)fresh * 1000000.0 / elapsed, 1);
+    Serial.print( ",");
+    Serial.print( percentile( 50));
+    Serial.print( ",");
+    Serial.print( percentile( 90));
+    Serial.print( ",");
+    Serial.print( percentile( 99));
+    Serial.print( ",");
+    Serial.print( latCount ? latency[ latCount - 1] : 0);
+    Serial.print( ",");
+    Serial.println( ( float)busTime * 100.0 / elapsed, 1);
+}
+
+// - - - -   BYTE: one register at a time   - - - -
+void runByte( uint8_t adr)
+{
+    uint8_t frame[ TFL_FRAME_TICK];
+    uint32_t t0 = micros();
+    while( micros() - t0 < RUN_MS * 1000UL)
+    {
+      uint32_t t = micros();
+      bool ok = true;
+      for( uint8_t reg = TFL_DIST_LO; ok && reg <= TFL_TICK_HI; ++reg)
+      {
+        // `readReg` keeps its reply private, so read the
+        // register block one byte at a time with `readRegs`.
+        ok = tflI2C.readRegs( reg, &frame[ reg], 1, adr);
+      }
+      uint32_t us = micros() - t;
+      uint16_t tick = frame[ 6] + ( frame[ 7] << 8);
+      addRead( us, ok && tick != lastTick);
+      lastTick = tick;
+    }
+}
+
+// - - - -   BURST: whole frame in one transaction   - - - -
+void runBurst( uint8_t adr)
+{
+    int16_t dist, flux, temp;
+    uint32_t t0 = micros();
+    while( micros() - t0 < RUN_MS * 1000UL)
+    {
+      uint32_t t = micros();
+      tflI2C.getFreshData( dist, flux, temp, lastTick, adr);
+      uint32_t us = micros() - t;
+      addRead( us, tflI2C.getStatus() != TFL_STALE &&
+                   tflI2C.getStatus() != TFL_I2CWRITE &&
+                   tflI2C.getStatus() != TFL_I2CREAD);
+    }
+}
+
+// - - - -   ASYNC: one bus phase per call   - - - -
+void runAsync( uint8_t adr)
+{
+    TFLFrame frm;
+    uint32_t t0 = micros();
+    while( micros() - t0 < RUN_MS * 1000UL)
+    {
+      uint32_t t = micros();
+      if( tflI2C.startRead( adr, NULL, TFL_FRAME_TICK))
+      {
+        // The sketch is free to work here between the phases.
+        tflI2C.poll();
+      }
+      bool ok = tflI2C.isReady();
+      if( ok) tflI2C.readResult( frm);
+      uint32_t us = micros() - t;
+      addRead( us, ok && frm.tick != lastTick);
+      if( ok) lastTick = frm.tick;
+    }
+}
+
+// - - - -   ARRAY: every device, scheduled by frame rate   - - - -
+void runArray( uint16_t fps)
+{
+    for( uint8_t i = 0; i < tflArray.count(); ++i)
+    {
+      tflArray.setFrameRate( i, fps);
+    }
+    int16_t dist, flux, temp;
+    uint32_t t0 = micros();
+    while( micros() - t0 < RUN_MS * 1000UL)
+    {
+      uint32_t t = micros();
+      int8_t i = tflArray.update();
+      if( i < 0) continue;
+      uint32_t us = micros() - t;
+      addRead( us, tflArray.getData( i, dist, flux, temp) ||
+                   tflArray.device( i).status == TFL_WEAK);
+    }
+}
+
+void setup()
+{
+    Serial.begin( 115200);  // initialize serial port
+    Wire.begin();           // initialize Wire library
+    tflI2C.Set_Bus( &Wire);
+    Serial.println( "TFLI2C benchmark"); // say "Hello!"
+    Serial.println( "14 OCT 2026");      // and add date
+
+    for( uint8_t i = 0; i < sizeof( tfAddr); ++i)
+    {
+      tflArray.addDevice( tfAddr[ i]);
+    }
+    tflArray.setFreshOnly( true);
+    Serial.print( "Devices online: ");
+    Serial.println( tflArray.begin());
+
+    Serial.println( "strategy,clock,fps,reads,new_fps,p50_us,p90_us,p99_us,max_us,bus_pct");
+    for( uint8_t f = 0; f < sizeof( fpsList) / sizeof( fpsList[ 0]); ++f)
+    {
+      uint16_t fps = fpsList[ f];
+      for( uint8_t i = 0; i < sizeof( tfAddr); ++i)
+      {
+        tflI2C.Set_Frame_Rate( fps, tfAddr[ i]);
+      }
+      delay( 100);          // let the new frame rate settle
+
+      for( uint8_t c = 0; c < sizeof( clkList) / sizeof( clkList[ 0]); ++c)
+      {
+        uint32_t clk = clkList[ c];
+        Wire.setClock( clk);
+
+        startRun();
+        runByte( tfAddr[ 0]);
+        printRun( "BYTE", clk, fps, RUN_MS * 1000UL);
+
+        startRun();
+        runBurst( tfAddr[ 0]);
+        printRun( "BURST", clk, fps, RUN_MS * 1000UL);
+
+        startRun();
+        runAsync( tfAddr[ 0]);
+        printRun( "ASYNC", clk, fps, RUN_MS * 1000UL);
+
+        startRun();
+        runArray( fps);
+        printRun( "ARRAY", clk, fps, RUN_MS * 1000UL);
+      }
+    }
+    Wire.setClock( 100000UL);
+    Serial.println( "Done");
+}
+
+void loop()
+{
+}
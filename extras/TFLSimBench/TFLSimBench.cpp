@@ -0,0 +1,212 @@
+/* File Name: TFLSimBench.cpp
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0
+ * Described: Host benchmark of the TFLI2C library read paths against
+ *            simulated TF-Luna devices on a `TFLSimBus`.
+ *
+ *  Build and run on a Linux or macOS host, from this folder:
+ *    g++ -std=gnu++11 -O2 -I../../src TFLSimBench.cpp ../../src/TFLI2C.cpp
+ *        ../../src/TFLI2CArray.cpp ../../src/TFLSimBus.cpp -o TFLSimBench
+ *    ./TFLSimBench > results.csv
+ *
+ *  For every bus clock in `clkList`, device frame rate in `fpsList` and
+ *  error rate in `errList`, each read strategy is run:
+ *    BURST - `getData` with the tick, one device
+ *    FRESH - `getFreshData`, one device
+ *    FRAME - `getFrame`, one device
+ *    MULTI - `getFrames` of all `DEVICES` devices
+ *    BATCH - `readBatch` of `BATCH_N` frames without pacing, one device
+ *    ARRAY - `TFLI2CArray::update` of all devices
+ *    ALL   - `TFLI2CArray::updateAll` of all devices
+ *
+ *  The single device and MULTI strategies run `LOOPS` calls in virtual
+ *  time, `LOOP_US` apart, so that their results are the same on every
+ *  host.  BATCH polls as fast as it can in virtual time.  The array
+ *  keeps its own schedule on `micros()`, so ARRAY and ALL run for
+ *  `RUN_MS` milliseconds of real time.
+ *
+ *  One line of comma separated values is printed for each run:
+ *    strategy, clock Hz, device fps, errors per 1000, calls, frames
+ *    made by the devices, new frames read, CPU nanoseconds per call and
+ *    simulated bus microseconds per call.  The CPU time is the time of
+ *    the library and the simulator together, and of any retry waits.
+ */
+
+#include <TFLI2C.h>
+#include <TFLI2CArray.h>
+#include <TFLSimBus.h>
+
+#define DEVICES     4       // simulated devices, from `TFL_DEF_ADR`
+#define LOOPS   20000       // calls of each virtual time run
+#define LOOP_US  1000       // virtual time between calls
+#define BATCH_N   256       // frames of each `readBatch`
+#define RUN_MS    200       // length of each real time run
+
+TFLSimBus sim;
+TFLI2C tflI2C;
+
+uint8_t tfAddr[ DEVICES];
+uint32_t clkList[] = { 100000UL, 400000UL, 1000000UL};
+uint16_t fpsList[] = { FPS_100, FPS_250};
+uint16_t errList[] = { 0, 50};
+
+#define COUNT( a)  ( sizeof( a) / sizeof( a[ 0]))
+
+// Results of one run
+struct Run
+{
+    uint32_t calls;
+    uint32_t fresh;          // reads with a new device tick
+    uint64_t cpuUs;
+};
+
+// Fresh devices at `fps`, every run starting from the same state
+void setup( uint32_t clk, uint16_t fps, uint16_t err, bool realTime)
+{
+    sim.reset();
+    sim.setSeed( 1);
+    sim.useMicros( realTime);
+    sim.setClock( clk);
+    for( uint8_t i = 0; i < DEVICES; ++i)
+    {
+      tfAddr[ i] = TFL_DEF_ADR + i;
+      sim.add( tfAddr[ i]);
+      sim.setTarget( tfAddr[ i], 100 + 50 * i, 1000, 2500, 2);
+      uint8_t *r = sim.regs( tfAddr[ i]);
+      r[ TFL_FPS_LO] = ( uint8_t)fps;
+      r[ TFL_FPS_HI] = ( uint8_t)( fps >> 8);
+      tflI2C.Clear_Cache( tfAddr[ i]);
+    }
+    sim.setErrorRate( err);
+    tflI2C.Set_Bus( &sim);
+}
+
+// Tick tracker for counting new frames of device `i`
+uint16_t lastTick[ DEVICES];
+bool isNew( uint8_t i, uint16_t tick)
+{
+    bool fresh = ( tick != lastTick[ i]);
+    lastTick[ i] = tick;
+    return fresh;
+}
+
+Run runVirtual( char strategy)
+{
+    Run run = { 0, 0, 0};
+    memset( lastTick, 0, sizeof( lastTick));
+    int16_t dist, flux, temp;
+    uint16_t tick = 0;
+    TFLFrame out[ DEVICES];
+
+    uint64_t start = tflHostMicros();
+    for( uint32_t n = 0; n < LOOPS; ++n)
+    {
+      switch( strategy)
+      {
+        case 'B':
+          if( tflI2C.getData( dist, flux, temp, tick, tfAddr[ 0]) &&
+              isNew( 0, tick)) ++run.fresh;
+          break;
+        case 'R':
+          if( tflI2C.getFreshData( dist, flux, temp, tick, tfAddr[ 0])) ++run.fresh;
+          break;
+        case 'F':
+        {
+          TFLFrame f = tflI2C.getFrame( tfAddr[ 0]);
+          if( f.ok() && isNew( 0, f.tick)) ++run.fresh;
+          break;
+        }
+        case 'M':
+          tflI2C.getFrames( tfAddr, DEVICES, out);
+          for( uint8_t i = 0; i < DEVICES; ++i)
+          {
+            if( out[ i].ok() && isNew( i, out[ i].tick)) ++run.fresh;
+          }
+          break;
+      }
+      ++run.calls;
+      sim.advance( LOOP_US);
+    }
+    run.cpuUs = tflHostMicros() - start;
+    return run;
+}
+
+Run runBatch()
+{
+    static TFLFrame out[ BATCH_N];
+    TFLBatchStats st;
+    uint64_t start = tflHostMicros();
+    tflI2C.readBatch( tfAddr[ 0], out, BATCH_N,
+                      TFLBatchOpts( TFL_BATCH_NO_PACE), &st);
+    Run run;
+    run.cpuUs = tflHostMicros() - start;
+    run.fresh = st.frames;
+    run.calls = st.frames + st.rejects + st.stale + st.busErrors;
+    return run;
+}
+
+Run runArray( bool all)
+{
+    Run run = { 0, 0, 0};
+    int16_t dist, flux, temp;
+    TFLI2CArray tflArray( tflI2C);
+    for( uint8_t i = 0; i < DEVICES; ++i) tflArray.addDevice( tfAddr[ i]);
+    tflArray.begin();
+    tflArray.setFreshOnly( true);
+
+    uint64_t start = tflHostMicros();
+    uint64_t end = start + RUN_MS * 1000ULL;
+    while( tflHostMicros() < end)
+    {
+      if( all) run.fresh += tflArray.updateAll();
+      else
+      {
+        int8_t i = tflArray.update();
+        if( i >= 0 && tflArray.getData( i, dist, flux, temp)) ++run.fresh;
+      }
+      ++run.calls;
+    }
+    run.cpuUs = tflHostMicros() - start;
+    return run;
+}
+
+void print( const char *name, uint32_t clk, uint16_t fps, uint16_t err, const Run &run)
+{
+    uint32_t calls = run.calls ? run.calls : 1;
+    printf( "%s,%lu,%u,%u,%lu,%lu,%lu,%lu,%lu\n", name,
+            ( unsigned long)clk, ( unsigned)fps, ( unsigned)err,
+            ( unsigned long)run.calls, ( unsigned long)sim.frames,
+            ( unsigned long)run.fresh,
+            ( unsigned long)( run.cpuUs * 1000 / calls),
+            ( unsigned long)( sim.busUs / calls));
+}
+
+int main()
+{
+    printf( "strategy,clock,fps,errors,calls,made,new,cpu ns,bus us\n");
+    for( size_t c = 0; c < COUNT( clkList); ++c)
+    for( size_t f = 0; f < COUNT( fpsList); ++f)
+    for( size_t e = 0; e < COUNT( errList); ++e)
+    {
+      uint32_t clk = clkList[ c];
+      uint16_t fps = fpsList[ f];
+      uint16_t err = errList[ e];
+
+      setup( clk, fps, err, false);
+      print( "BURST", clk, fps, err, runVirtual( 'B'));
+      setup( clk, fps, err, false);
+      print( "FRESH", clk, fps, err, runVirtual( 'R'));
+      setup( clk, fps, err, false);
+      print( "FRAME", clk, fps, err, runVirtual( 'F'));
+      setup( clk, fps, err, false);
+      print( "MULTI", clk, fps, err, runVirtual( 'M'));
+      setup( clk, fps, err, false);
+      print( "BATCH", clk, fps, err, runBatch());
+      setup( clk, fps, err, true);
+      print( "ARRAY", clk, fps, err, runArray( false));
+      setup( clk, fps, err, true);
+      print( "ALL", clk, fps, err, runArray( true));
+    }
+    return 0;
+}
@@ -0,0 +1,236 @@
+/* File Name: TFLAdaptive.cpp
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Adaptive frame rate control for the Benewake TF-Luna
+ *            Lidar sensor configured for the I2C interface.
+ *
+ *  Typical use:
+ *    TFLI2C tflI2C;
+ *    TFLAdaptive tflAdapt( tflI2C);
+ *    ...
+ *    tflAdapt.begin( TFL_DEF_ADR, FPS_5, FPS_250);
+ *    ...
+ *    if( tflAdapt.update() && tflAdapt.getData( dist, flux, temp)) ...
+ */
+
+#include <TFLAdaptive.h>
+
+// The frame rate ladder, slowest first
+static const uint16_t ladder[ TFL_ADAPT_STEPS] =
+{
+    FPS_1, FPS_2, FPS_5, FPS_10, FPS_35, FPS_50, FPS_100, FPS_125, FPS_250
+};
+
+// Constructor/Destructor
+TFLAdaptive::TFLAdaptive( TFLI2C &_tfl) : tfl( _tfl)
+{
+    addr = TFL_DEF_ADR;
+    lo = 0;
+    hi = TFL_ADAPT_STEPS - 1;
+    step = hi;
+    demand = 0;
+    stepCm = TFL_ADAPT_STEP_CM;
+    nearCm = TFL_ADAPT_NEAR_CM;
+    nearFps = FPS_250;
+    lowFlux = TFL_ADAPT_LOW_FLUX;
+    holdMs = TFL_ADAPT_HOLD_MS;
+    downMs = TFL_ADAPT_DOWN_MS;
+    due = 0;
+    wroteMs = 0;
+    lowerMs = 0;
+    writes = 0;
+    speed = 0;
+    first = true;
+    fresh = false;
+    lower = false;
+}
+TFLAdaptive::~TFLAdaptive(){}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              SET UP
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TFLAdaptive::begin( uint8_t _addr, uint16_t minFps, uint16_t maxFps)
+{
+    addr = _addr;
+    lo = stepOf( minFps);
+    hi = stepOf( maxFps);
+    if( hi < lo) hi = lo;
+    speed = 0;
+    writes = 0;
+    first = true;
+    fresh = false;
+    lower = false;
+
+    uint16_t fps = ladder[ hi];
+    if( !tfl.Set_Cont_Mode( addr) || !tfl.Set_Frame_Rate( fps, addr)) return false;
+    step = hi;
+    ++writes;
+    wroteMs = millis();
+    due = micros();
+    return true;
+}
+
+void TFLAdaptive::setDemand( uint16_t fps)
+{
+    demand = fps;
+}
+
+void TFLAdaptive::setStep( uint16_t _stepCm)
+{
+    stepCm = _stepCm;
+}
+
+void TFLAdaptive::setNear( int16_t _nearCm, uint16_t _nearFps)
+{
+    nearCm = _nearCm;
+    nearFps = _nearFps;
+}
+
+void TFLAdaptive::setLowFlux( uint16_t _lowFlux)
+{
+    lowFlux = _lowFlux;
+}
+
+void TFLAdaptive::setTiming( uint16_t _holdMs, uint16_t _downMs)
+{
+    holdMs = _holdMs;
+    downMs = _downMs;
+}
+
+uint16_t TFLAdaptive::getFrameRate()
+{
+    return ladder[ step];
+}
+
+uint16_t TFLAdaptive::getSpeed()
+{
+    return speed;
+}
+
+uint32_t TFLAdaptive::getWrites()
+{
+    return writes;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              READ AND ADAPT
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Read once a frame period.  A frame already read is looked for
+// again after a quarter period, as `TFLI2CArray` does.
+bool TFLAdaptive::update()
+{
+    uint32_t now = micros();
+    if( ( int32_t)( now - due) < 0) return false;
+
+    uint32_t period = 1000000UL / ladder[ step];
+    TFLFrame f;
+    tfl.getData( f, addr);
+    if( f.status == TFLStatus::I2CRead || f.status == TFLStatus::I2CWrite ||
+        f.status == TFLStatus::Timeout)
+    {
+      due = now + period;
+      return false;
+    }
+    if( !first && f.tick == frame.tick)
+    {
+      due = now + ( period >> 2);
+      return false;
+    }
+
+    // Take a rise of speed at once, so that the rate goes up without
+    // delay.  Smooth a fall over about four frames: s += ( v - s) / 4
+    uint16_t dt = f.tick - frame.tick;
+    if( !first && dt > 0 && f.ok() && frame.ok())
+    {
+      int32_t dd = ( int32_t)f.dist - frame.dist;
+      if( dd < 0) dd = -dd;
+      int32_t v = dd * 1000 / dt;
+      int32_t s = ( v > speed) ? v : speed + ( v - speed) / 4;
+      speed = ( s > 0xFFFF) ? 0xFFFF : ( uint16_t)s;
+    }
+
+    frame = f;
+    first = false;
+    fresh = true;
+    adapt();
+    due = now + 1000000UL / ladder[ step];    // at the new rate
+    return true;
+}
+
+bool TFLAdaptive::getData( int16_t &dist, int16_t &flux, int16_t &temp)
+{
+    dist = frame.dist;
+    flux = frame.flux;
+    temp = frame.temp;
+    bool ok = fresh && frame.ok();
+    fresh = false;
+    return ok;
+}
+
+// Smallest ladder step of at least `fps`
+uint8_t TFLAdaptive::stepOf( uint16_t fps)
+{
+    for( uint8_t i = 0; i < TFL_ADAPT_STEPS; ++i)
+    {
+      if( ladder[ i] >= fps) return i;
+    }
+    return TFL_ADAPT_STEPS - 1;
+}
+
+// The ladder step the last frame asks for
+uint8_t TFLAdaptive::wanted()
+{
+    uint32_t need = stepCm ? speed / stepCm : 0;
+    if( need < demand) need = demand;
+    if( nearFps && frame.ok() && frame.dist < nearCm && need < nearFps) need = nearFps;
+
+    uint8_t to = stepOf( need > 0xFFFF ? 0xFFFF : need);
+    if( to < lo) to = lo;
+    if( to > hi) to = hi;
+
+    bool weak = ( frame.status == TFLStatus::Weak) ||
+                ( lowFlux && ( uint16_t)frame.flux < lowFlux);
+    if( weak && to >= step) to = ( step > lo) ? step - 1 : lo;
+    return to;
+}
+
+// Step up at once.  Step down one preset after a lower one
+// has been enough for `downMs`.
+void TFLAdaptive::adapt()
+{
+    uint32_t ms = millis();
+    uint8_t to = wanted();
+
+    if( to > step)
+    {
+      lower = false;
+      moveTo( to, ms);
+    }
+    else if( to < step)
+    {
+      if( !lower)
+      {
+        lower = true;
+        lowerMs = ms;
+      }
+      else if( ms - lowerMs >= downMs && moveTo( step - 1, ms))
+      {
+        lower = false;
+      }
+    }
+    else lower = false;
+}
+
+// Write the rate of ladder step `to`, if the last write
+// was at least `holdMs` ago.  True if it was written.
+bool TFLAdaptive::moveTo( uint8_t to, uint32_t ms)
+{
+    if( ms - wroteMs < holdMs) return false;
+    uint16_t fps = ladder[ to];
+    if( !tfl.Set_Frame_Rate( fps, addr)) return false;
+    step = to;
+    wroteMs = ms;
+    ++writes;
+    return true;
+}
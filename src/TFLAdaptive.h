@@ -0,0 +1,116 @@
+/* File Name: TFLAdaptive.h
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Adaptive frame rate control for the Benewake TF-Luna
+ *            Lidar sensor configured for the I2C interface.
+ *
+ *  A `TFLAdaptive` object reads one device and moves its frame rate up
+ *  and down the `FPS_*` presets, between a lowest and a highest rate,
+ *  so that a static scene is read slowly and a moving or near target
+ *  quickly.  A lower frame rate means fewer reads on the bus and, with
+ *  the longer exposure of each frame, a stronger signal.
+ *
+ *  At each new frame the rate needed is the largest of:
+ *    - the speed of the target, in cm/s, over `stepCm`, so that the
+ *      target moves about `stepCm` centimeters between frames.  The
+ *      speed is the change of distance over the change of device tick.
+ *      A rise is taken at once and a fall is smoothed over about four
+ *      frames.
+ *    - `nearFps` while the target is closer than `nearCm`.
+ *    - the rate the consumer asked for with `setDemand`.
+ *  While the flux is below `lowFlux` the rate is not raised, and is
+ *  lowered one step, since a longer exposure gives a stronger signal.
+ *
+ *  The rate goes up at once to the preset needed, but goes down one
+ *  preset at a time, and only after the lower rate has been enough for
+ *  `downMs` milliseconds.  No two rate writes are less than `holdMs`
+ *  milliseconds apart.  Writes go through `Set_Frame_Rate`, whose cache
+ *  skips a write of the rate the device already has.
+ *
+ *  The rate is not saved, so a power cycle restores the saved rate.
+ *  The low frame rates are used in normal power mode: `FPS_1` to
+ *  `FPS_10` do not switch the device to low power.
+ */
+
+#ifndef TFLADAPTIVE_H
+#define TFLADAPTIVE_H
+
+#include <TFLI2C.h>
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//      Definitions
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#define TFL_ADAPT_STEPS      9   // presets of the frame rate ladder
+#define TFL_ADAPT_STEP_CM    2   // target travel between frames, cm
+#define TFL_ADAPT_NEAR_CM   50   // closer than this is near
+#define TFL_ADAPT_LOW_FLUX 200   // flux below this is a weak signal
+#define TFL_ADAPT_HOLD_MS  250   // shortest time between rate writes
+#define TFL_ADAPT_DOWN_MS 2000   // time a lower rate must be enough
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                 OBJECT CLASS DEFINITIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+class TFLAdaptive
+{
+  public:
+    TFLAdaptive( TFLI2C &tfl);
+    ~TFLAdaptive();
+
+    // Adapt the frame rate of device `addr` between the presets
+    // nearest `minFps` and `maxFps`, starting from `maxFps`.
+    // Returns false if the device did not answer.
+    bool begin( uint8_t addr, uint16_t minFps = FPS_1, uint16_t maxFps = FPS_250);
+
+    // Read the device when a new frame is due and adapt the rate.
+    // Returns true when a new frame is ready to be taken.
+    bool update();
+    // Take the last frame.  Returns false if it is not valid.
+    bool getData( int16_t &dist, int16_t &flux, int16_t &temp);
+
+    // Lowest rate the consumer needs, 0 for none
+    void setDemand( uint16_t fps);
+    // Target travel between frames, in cm
+    void setStep( uint16_t stepCm);
+    // Rate while the target is closer than `nearCm`, 0 for none
+    void setNear( int16_t nearCm, uint16_t nearFps);
+    // Flux below which the rate is lowered, 0 for never
+    void setLowFlux( uint16_t lowFlux);
+    // Shortest time between writes, and time before stepping down
+    void setTiming( uint16_t holdMs, uint16_t downMs);
+
+    uint16_t getFrameRate();    // rate the device is set to
+    uint16_t getSpeed();        // smoothed target speed in cm/s
+    uint32_t getWrites();       // frame rate writes made
+
+  private:
+    TFLI2C &tfl;
+    uint8_t  addr;
+    uint8_t  lo, hi;         // ladder steps of the bounds
+    uint8_t  step;           // ladder step the device is set to
+    uint16_t demand;
+    uint16_t stepCm;
+    int16_t  nearCm;
+    uint16_t nearFps;
+    uint16_t lowFlux;
+    uint16_t holdMs;
+    uint16_t downMs;
+    uint32_t due;            // `micros()` time of the next read
+    uint32_t wroteMs;        // `millis()` time of the last rate write
+    uint32_t lowerMs;        // `millis()` time a lower rate became enough
+    bool     lower;          // a lower rate is enough
+    uint32_t writes;
+    uint16_t speed;          // smoothed speed, cm/s
+    bool     first;          // no frame read yet
+    bool     fresh;          // frame not yet taken
+    TFLFrame frame;          // last frame
+
+    static uint8_t stepOf( uint16_t fps);
+    uint8_t wanted();
+    void adapt();
+    bool moveTo( uint8_t to, uint32_t ms);
+};
+
+#endif  // TFLADAPTIVE_H
@@ -0,0 +1,174 @@
+/* File Name: TFLClock.cpp
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Relates the tick of a TF-Luna device to the `micros()`
+ *            clock of the host.
+ *
+ *  The sums are in 64-bit integers, so that the drift is kept to
+ *  parts per billion without floating point.  The slope is worked out
+ *  once a window, so the cost of a frame is a few additions.
+ */
+
+#include <TFLClock.h>
+
+#define TFL_PPB  1000000000LL
+
+// Constructor
+TFLClock::TFLClock()
+{
+    windowMs = TFL_CLOCK_WINDOW_MS;
+    reset();
+}
+
+void TFLClock::reset()
+{
+    first = true;
+    lastTick = 0;
+    lastRead = 0;
+    devMs = 0;
+    hostUs = 0;
+    base = 0;
+    refUs = 0;
+    driftPpb = 0;
+    winStart = 0;
+    winUs = 0;
+    winLow = 0;
+    points = 0;
+}
+
+void TFLClock::setWindow( uint16_t ms)
+{
+    windowMs = ms ? ms : 1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              FRAMES
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+uint64_t TFLClock::update( uint16_t tick, uint32_t readUs)
+{
+    if( first)
+    {
+      first = false;
+      lastTick = tick;
+      lastRead = readUs;
+      devMs = tick;
+      hostUs = readUs;
+      uint64_t devUs = devMs * 1000;
+      base = ( int64_t)( hostUs - devUs);
+      refUs = devUs;
+      winStart = devUs;
+      winUs = devUs;
+      winLow = base;
+      return devUs;
+    }
+
+    // The host time between the frames tells how often the tick
+    // wrapped, within half a wrap
+    uint32_t gap = readUs - lastRead;
+    uint32_t step = ( uint16_t)( tick - lastTick);
+    uint32_t gapMs = gap / 1000;
+    if( gapMs > step + 0x8000UL) step += ( ( gapMs - step + 0x8000UL) >> 16) << 16;
+    devMs += step;
+    hostUs += gap;
+    lastTick = tick;
+    lastRead = readUs;
+
+    uint64_t devUs = devMs * 1000;
+    int64_t d = ( int64_t)( hostUs - devUs);
+
+    // Keep the line under every point
+    if( d < line( devUs))
+    {
+      base = d;
+      refUs = devUs;
+    }
+    if( d < winLow)
+    {
+      winLow = d;
+      winUs = devUs;
+    }
+    if( devUs - winStart >= ( uint64_t)windowMs * 1000)
+    {
+      endWindow();
+      winStart = devUs;
+      winUs = devUs;
+      winLow = d;
+    }
+    return devUs;
+}
+
+// Keep the lowest point of the window, measure the slope and put
+// the line through that point
+void TFLClock::endWindow()
+{
+    if( points == TFL_CLOCK_POINTS)
+    {
+      for( uint8_t i = 1; i < TFL_CLOCK_POINTS; ++i)
+      {
+        ptUs[ i - 1] = ptUs[ i];
+        ptLow[ i - 1] = ptLow[ i];
+      }
+      --points;
+    }
+    ptUs[ points] = winUs;
+    ptLow[ points] = winLow;
+    ++points;
+
+    if( points >= 2)
+    {
+      int64_t dLow = ptLow[ points - 1] - ptLow[ 0];
+      int64_t dUs = ( int64_t)( ptUs[ points - 1] - ptUs[ 0]);
+      if( dUs > 0) driftPpb = ( int32_t)( dLow * TFL_PPB / dUs);
+    }
+    base = winLow;
+    refUs = winUs;
+}
+
+void TFLClock::stamp( const TFLFrame &f, uint32_t readUs, TFLTimed &out)
+{
+    out.frame = f;
+    out.devUs = update( f.tick, readUs);
+    out.hostUs = toHostUs( out.devUs);
+    out.readUs = hostUs;
+}
+
+// The tick is read in the same burst as the data, so the middle of
+// the read is the host time of the tick
+bool TFLClock::read( TFLI2C &tfl, uint8_t addr, TFLTimed &out)
+{
+    TFLFrame f;
+    uint32_t start = micros();
+    if( !tfl.getData( f, addr)) return false;
+    uint32_t end = micros();
+    stamp( f, start + ( end - start) / 2, out);
+    return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              CLOCK LINE
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+int64_t TFLClock::line( uint64_t devUs)
+{
+    return base + ( int64_t)driftPpb * ( int64_t)( devUs - refUs) / TFL_PPB;
+}
+
+uint64_t TFLClock::toHostUs( uint64_t devUs)
+{
+    return devUs + line( devUs);
+}
+
+int64_t TFLClock::getOffsetUs()
+{
+    return line( devMs * 1000);
+}
+
+int32_t TFLClock::getDriftPpb()
+{
+    return driftPpb;
+}
+
+bool TFLClock::isLocked()
+{
+    return points >= 2;
+}
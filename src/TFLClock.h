@@ -0,0 +1,124 @@
+/* File Name: TFLClock.h
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Relates the tick of a TF-Luna device to the `micros()`
+ *            clock of the host.
+ *
+ *  The tick read with each frame is the device time of the frame in
+ *  milliseconds, 16 bits wide, so it wraps every 65.5 seconds.  Fed
+ *  with the tick of each frame and the `micros()` time it was read,
+ *  a `TFLClock` object:
+ *    - unwraps the tick, and `micros()`, into 64-bit microseconds
+ *    - keeps a line `host = device + offset`, with the offset moving by
+ *      `drift` parts per billion of device time
+ *    - maps the device time of a frame onto the host clock, so that
+ *      the frames of several devices can be lined up.
+ *
+ *  A read always comes after the frame, by a delay that varies.  The
+ *  shortest delay is the best guess of the offset, so the line is kept
+ *  under every point (host - device) seen.  Once each `window` of
+ *  device time the lowest point of the window is kept, and the drift
+ *  is the slope from the oldest of the last `TFL_CLOCK_POINTS` lowest
+ *  points to the newest.  With the default window of 8 seconds and a
+ *  1 millisecond tick the drift is known to about 30 ppm after half a
+ *  minute, and keeps improving while the device keeps the same rate.
+ *
+ *  The offset takes in the shortest delay seen, so the latency of a
+ *  frame, `readUs - hostUs`, is measured from the fastest read and not
+ *  from the true moment of the frame.  Feed the clock at least once a
+ *  minute: it uses the `micros()` time between two frames to count
+ *  the wraps of the tick over longer gaps.  Call `reset()` after the
+ *  device is reset, as its tick then starts again from zero.
+ *
+ *  Typical use:
+ *    TFLI2C tflI2C;
+ *    TFLClock tflClock;
+ *    TFLTimed t;
+ *    ...
+ *    if( tflClock.read( tflI2C, addr, t)) latency = t.latency();
+ */
+
+#ifndef TFLCLOCK_H
+#define TFLCLOCK_H
+
+#include <TFLI2C.h>
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//      Definitions
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#define TFL_CLOCK_WINDOW_MS  8000   // device time of one lowest point
+#define TFL_CLOCK_POINTS        4   // lowest points kept for the drift
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                 OBJECT CLASS DEFINITIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// One frame with its time on both clocks
+struct TFLTimed
+{
+    TFLFrame frame;
+    uint64_t devUs;      // unwrapped device time of the frame
+    uint64_t hostUs;     // the same moment on the host clock
+    uint64_t readUs;     // host time the frame was read
+
+    uint32_t latency() const { return ( uint32_t)( readUs - hostUs);}
+};
+
+class TFLClock
+{
+  public:
+    TFLClock();
+
+    // Forget the device and start again
+    void reset();
+    // Device time of one lowest point, in milliseconds
+    void setWindow( uint16_t ms);
+
+    // Add the `tick` of a frame read at `micros()` time `readUs`.
+    // Returns the unwrapped device time of the frame.
+    uint64_t update( uint16_t tick, uint32_t readUs);
+    // Add frame `f` and pass it back in `out` with its times
+    void stamp( const TFLFrame &f, uint32_t readUs, TFLTimed &out);
+    // Read a frame of device `addr` and stamp it.  Returns false if
+    // the read failed, in which case the clock is not changed.
+    bool read( TFLI2C &tfl, uint8_t addr, TFLTimed &out);
+
+    // Host time of device time `devUs`
+    uint64_t toHostUs( uint64_t devUs);
+    // Host less device time at the last frame, in microseconds
+    int64_t  getOffsetUs();
+    // Device clock slower than the host, in parts per billion
+    int32_t  getDriftPpb();
+    // True once the drift has been measured
+    bool     isLocked();
+
+  private:
+    uint16_t windowMs;
+    bool     first;
+    uint16_t lastTick;
+    uint32_t lastRead;
+    uint64_t devMs;          // unwrapped tick
+    uint64_t hostUs;         // unwrapped `micros()`
+
+    // The line: host - device = base + drift * ( device - refUs)
+    int64_t  base;
+    uint64_t refUs;
+    int32_t  driftPpb;
+
+    // Lowest point of the window so far
+    uint64_t winStart;
+    uint64_t winUs;
+    int64_t  winLow;
+
+    // The last lowest points, oldest first
+    uint64_t ptUs[ TFL_CLOCK_POINTS];
+    int64_t  ptLow[ TFL_CLOCK_POINTS];
+    uint8_t  points;
+
+    int64_t line( uint64_t devUs);
+    void    endWindow();
+};
+
+#endif  // TFLCLOCK_H
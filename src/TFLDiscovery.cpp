@@ -0,0 +1,200 @@
+/* File Name: TFLDiscovery.cpp
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Finds and identifies the TF-Luna devices on an I2C bus,
+ *            with a cache of their identities for the next boot.
+ *
+ *  A scan keeps the identities of the addresses that still answer,
+ *  reads those of new addresses and drops those that did not answer.
+ *  Devices beyond `TFL_ID_MAX` are not listed.  The new table is
+ *  built in place in `cache`, so that a scan needs little stack.
+ */
+
+#include <TFLDiscovery.h>
+
+// Constructor/Destructor
+TFLDiscovery::TFLDiscovery( TFLI2C &_tfl) : tfl( _tfl)
+{
+    clear();
+}
+TFLDiscovery::~TFLDiscovery(){}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              SCAN
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+uint8_t TFLDiscovery::scan( uint8_t first, uint8_t last)
+{
+    uint32_t start = micros();
+    cached = false;
+    dirty = false;
+    identified = 0;
+
+    // Probe every address
+    uint8_t found[ TFL_ID_MAX];
+    uint8_t n = 0;
+    for( uint16_t a = first; a <= last && n < TFL_ID_MAX; ++a)
+    {
+      if( tfl.probe( a)) found[ n++] = a;
+    }
+
+    // The same addresses as the cache, all identified: nothing more to read
+    bool same = ( n == cache.count);
+    for( uint8_t i = 0; same && i < n; ++i)
+    {
+      same = ( cache.id[ i].addr == found[ i]) && ( cache.id[ i].flags & TFL_ID_READ);
+    }
+    if( same)
+    {
+      cached = true;
+      scanUs = micros() - start;
+      return n;
+    }
+
+    // Drop the identities of the addresses that did not answer.
+    // Both lists are in address order.
+    uint8_t m = 0;
+    for( uint8_t k = 0, i = 0; k < cache.count; ++k)
+    {
+      while( i < n && found[ i] < cache.id[ k].addr) ++i;
+      if( i < n && found[ i] == cache.id[ k].addr) cache.id[ m++] = cache.id[ k];
+    }
+
+    // Merge in the new addresses from the end, where an identity
+    // never moves down over one not yet moved, and list those
+    // still to be identified
+    uint8_t want[ TFL_ID_MAX];       // index in `cache` to identify
+    uint8_t nw = 0;
+    int8_t j = ( int8_t)m - 1;
+    for( int8_t i = ( int8_t)n - 1; i >= 0; --i)
+    {
+      TFLIdent &id = cache.id[ i];
+      if( j >= 0 && cache.id[ j].addr == found[ i]) id = cache.id[ j--];
+      else
+      {
+        memset( &id, 0, sizeof( id));
+        id.addr = found[ i];
+      }
+      if( !( id.flags & TFL_ID_READ)) want[ nw++] = i;
+    }
+    cache.magic = TFL_ID_MAGIC;
+    cache.count = n;
+    memset( cache.id + n, 0, ( TFL_ID_MAX - n) * sizeof( TFLIdent));
+
+    // `found` is free again: the addresses to identify
+    for( uint8_t w = 0; w < nw; ++w) found[ w] = cache.id[ want[ w]].addr;
+
+    // One identification burst for `TFL_ID_GROUP` new devices
+    uint8_t buf[ TFL_ID_GROUP * TFL_ID_LEN];
+    uint8_t status[ TFL_ID_GROUP];
+    for( uint8_t g = 0; g < nw; g += TFL_ID_GROUP)
+    {
+      uint8_t k = nw - g;
+      if( k > TFL_ID_GROUP) k = TFL_ID_GROUP;
+      tfl.readRegs( found + g, k, TFL_ID_FIRST, buf, TFL_ID_LEN, status);
+      for( uint8_t i = 0; i < k; ++i)
+      {
+        if( status[ i] != TFL_READY) continue;
+        TFLIdent &id = cache.id[ want[ g + i]];
+        const uint8_t *b = buf + i * TFL_ID_LEN;
+        memcpy( id.ver, b, 3);
+        memcpy( id.code, b + ( TFL_PROD_CODE - TFL_ID_FIRST), TFL_PROD_LEN);
+        id.flags = TFL_ID_READ;
+        if( looksLuna( id)) id.flags |= TFL_ID_LUNA;
+        ++identified;
+      }
+    }
+
+    cache.check = checksum( cache);
+    dirty = true;
+    scanUs = micros() - start;
+    return n;
+}
+
+// A firmware version and a production code of printable characters
+bool TFLDiscovery::looksLuna( const TFLIdent &id)
+{
+    if( id.ver[ 0] == 0 && id.ver[ 1] == 0 && id.ver[ 2] == 0) return false;
+    if( id.code[ 0] < 0x20 || id.code[ 0] > 0x7E) return false;
+    for( uint8_t i = 1; i < TFL_PROD_LEN; ++i)
+    {
+      uint8_t c = id.code[ i];
+      if( c != 0 && ( c < 0x20 || c > 0x7E)) return false;
+    }
+    return true;
+}
+
+bool TFLDiscovery::fromCache()
+{
+    return cached;
+}
+
+bool TFLDiscovery::changed()
+{
+    return dirty;
+}
+
+uint32_t TFLDiscovery::getScanUs()
+{
+    return scanUs;
+}
+
+uint8_t TFLDiscovery::getIdentified()
+{
+    return identified;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              IDENTITY TABLE
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+uint8_t TFLDiscovery::count()
+{
+    return cache.count;
+}
+
+const TFLIdent &TFLDiscovery::ident( uint8_t idx)
+{
+    return cache.id[ idx];
+}
+
+int8_t TFLDiscovery::find( uint8_t addr)
+{
+    for( uint8_t i = 0; i < cache.count; ++i)
+    {
+      if( cache.id[ i].addr == addr) return i;
+    }
+    return -1;
+}
+
+bool TFLDiscovery::setCache( const TFLIdCache &c)
+{
+    if( c.magic != TFL_ID_MAGIC || c.count > TFL_ID_MAX || c.check != checksum( c))
+    {
+      clear();
+      return false;
+    }
+    cache = c;
+    return true;
+}
+
+const TFLIdCache &TFLDiscovery::getCache()
+{
+    return cache;
+}
+
+void TFLDiscovery::clear()
+{
+    memset( &cache, 0, sizeof( cache));
+    cache.magic = TFL_ID_MAGIC;
+    cache.check = checksum( cache);
+    cached = false;
+    dirty = false;
+    scanUs = 0;
+    identified = 0;
+}
+
+uint8_t TFLDiscovery::checksum( const TFLIdCache &c)
+{
+    uint8_t crc = tflCrc8( &c.count, 1);
+    return tflCrc8( ( const uint8_t *)c.id, c.count * sizeof( TFLIdent), crc);
+}
@@ -0,0 +1,133 @@
+/* File Name: TFLDiscovery.h
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Finds and identifies the TF-Luna devices on an I2C bus,
+ *            with a cache of their identities for the next boot.
+ *
+ *  `scan()` sends only the address byte to every address from `first`
+ *  to `last` and lists those that acknowledge.  Each probe is a few
+ *  bytes of bus time, so the whole range 0x08 to 0x77 takes about 12ms
+ *  at 100kHz.
+ *
+ *  A device not in the cache is identified with one burst read of the
+ *  registers `TFL_ID_FIRST` to 0x1D: firmware version and production
+ *  code.  The bursts of several devices are handed to the transport
+ *  together, as `getFrames` does.  A device whose version and code
+ *  look like those of a TF-Luna is marked `TFL_ID_LUNA`.
+ *
+ *  The identities are kept in a `TFLIdCache`, a plain record with a
+ *  check byte that a sketch can keep in EEPROM or flash.  Give it back
+ *  with `setCache()` at the next boot.  If the same addresses answer,
+ *  `scan()` takes the identities from the cache and reads no more.
+ *  Only the addresses are compared, so call `clear()` before a scan
+ *  after swapping a device for another at the same address.
+ *
+ *  Typical use:
+ *    TFLI2C tflI2C;
+ *    TFLDiscovery tflFind( tflI2C);
+ *    TFLIdCache cache;
+ *    ...
+ *    EEPROM.get( 0, cache);
+ *    tflFind.setCache( cache);           // false if not valid
+ *    uint8_t n = tflFind.scan();
+ *    if( tflFind.changed()) EEPROM.put( 0, tflFind.getCache());
+ *    for( uint8_t i = 0; i < n; ++i)
+ *      if( tflFind.ident( i).flags & TFL_ID_LUNA) ...
+ */
+
+#ifndef TFLDISCOVERY_H
+#define TFLDISCOVERY_H
+
+#include <TFLI2C.h>
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//      Definitions
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#define TFL_SCAN_FIRST    0x08   // range of 7-bit device addresses
+#define TFL_SCAN_LAST     0x77
+#define TFL_ID_MAX          16   // devices kept in the cache
+#define TFL_ID_FIRST  TFL_VER_REV
+#define TFL_ID_LEN          20   // registers 0x0A to 0x1D
+#define TFL_ID_MAGIC      0x5A   // first byte of a valid cache
+
+// New devices identified in one `readRegs`, each taking `TFL_ID_LEN`
+// bytes of stack.  One at a time on AVR, where `Wire` reads them one
+// at a time anyway.
+#ifndef TFL_ID_GROUP
+  #if defined( __AVR__)
+    #define TFL_ID_GROUP     1
+  #else
+    #define TFL_ID_GROUP     TFL_MULTI_DEVICES
+  #endif
+#endif
+
+// Flags of an identity
+#define TFL_ID_READ       0x01   // identification registers were read
+#define TFL_ID_LUNA       0x02   // they look like those of a TF-Luna
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                 OBJECT CLASS DEFINITIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// Identity of one device that answered
+struct TFLIdent
+{
+    uint8_t addr;                   // I2C address
+    uint8_t flags;                  // `TFL_ID_READ`, `TFL_ID_LUNA`
+    uint8_t ver[ 3];                // firmware revision, minor, major
+    uint8_t code[ TFL_PROD_LEN];    // production code
+};
+
+// The identities of one bus, in address order
+struct TFLIdCache
+{
+    uint8_t  magic;                 // `TFL_ID_MAGIC`
+    uint8_t  count;                 // identities in use
+    uint8_t  check;                 // CRC-8 of `count` and `id`
+    TFLIdent id[ TFL_ID_MAX];
+};
+
+class TFLDiscovery
+{
+  public:
+    TFLDiscovery( TFLI2C &tfl);
+    ~TFLDiscovery();
+
+    // Find the devices from `first` to `last` and identify those not
+    // in the cache.  Returns the number of devices found.
+    uint8_t scan( uint8_t first = TFL_SCAN_FIRST, uint8_t last = TFL_SCAN_LAST);
+
+    // True if the last scan found the cached addresses and read nothing
+    bool fromCache();
+    // True if the last scan changed the cache, so that it should be kept
+    bool changed();
+
+    uint8_t count();
+    const TFLIdent &ident( uint8_t idx);
+    // Index of the device at `addr`, or -1
+    int8_t find( uint8_t addr);
+
+    // Use a cache kept from an earlier boot.  False if it is not valid,
+    // and the cache is then cleared.
+    bool setCache( const TFLIdCache &c);
+    const TFLIdCache &getCache();
+    void clear();
+
+    uint32_t getScanUs();        // time of the last scan
+    uint8_t  getIdentified();    // devices read by the last scan
+
+  private:
+    TFLI2C &tfl;
+    TFLIdCache cache;
+    bool     cached;
+    bool     dirty;
+    uint32_t scanUs;
+    uint8_t  identified;
+
+    static uint8_t checksum( const TFLIdCache &c);
+    static bool looksLuna( const TFLIdent &id);
+};
+
+#endif  // TFLDISCOVERY_H
@@ -0,0 +1,198 @@
+/* File Name: TFLFilter.h
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Streaming distance filters for the Benewake TF-Luna
+ *            Lidar sensor, in integer and fixed-point arithmetic.
+ *
+ *  Each filter takes one sample at a time and passes back the filtered
+ *  distance at once.  Nothing is allocated: the size of each filter is
+ *  fixed at compile time, and no floating point is used, so that the
+ *  filters are cheap on 8-bit AVR.  Push only good frames, those for
+ *  which `getData` returned true, into a filter.
+ *
+ *    TFLMedian< N>  - median of the last `N` samples.  Keeps the window
+ *                     in sorted order by insertion, so each sample costs
+ *                     at most two passes over the window and no sort.
+ *    TFLEma< S>     - exponential moving average with a weight of 1/2^S
+ *                     for each new sample.
+ *    TFLKalman      - 1-D Kalman filter for a distance that changes
+ *                     slowly.  The measurement noise of each sample is
+ *                     taken from its signal strength `flux`, so a weak
+ *                     sample moves the estimate less than a strong one.
+ *
+ *  Filters can be chained by passing the output of one to the next,
+ *  or used on a `TFLFrame` with `update( frame)`, which filters the
+ *  distance of the frame in place.
+ *
+ *  Example:
+ *    TFLMedian< 5> median;
+ *    TFLEma< 2> ema;
+ *    ...
+ *    if( tflI2C.getData( dist, flux, temp, addr))
+ *      dist = ema.update( median.update( dist));
+ */
+
+#ifndef TFLFILTER_H
+#define TFLFILTER_H
+
+#include <TFLI2C.h>
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//      Definitions
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#define TFL_KALMAN_Q         4   // default process noise, cm^2 per sample
+#define TFL_KALMAN_R       100   // default noise at flux 100, cm^2
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                 OBJECT CLASS DEFINITIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// - - - -   Median over a sliding window   - - - -
+template< uint8_t N>
+class TFLMedian
+{
+    static_assert( N >= 1, "TFLMedian window must hold at least one sample");
+
+  public:
+    TFLMedian() { reset();}
+
+    void reset() { count = 0; oldest = 0;}
+
+    int16_t update( int16_t x)
+    {
+        uint8_t i;
+        if( count < N)
+        {
+          win[ count] = x;            // fill the window first
+          i = count++;
+        }
+        else
+        {
+          // Take the oldest sample out of the sorted window...
+          int16_t old = win[ oldest];
+          win[ oldest] = x;
+          oldest = ( oldest + 1) % N;
+          for( i = 0; sorted[ i] != old; ++i) {}
+          for( ; i + 1 < N; ++i) sorted[ i] = sorted[ i + 1];
+          i = N - 1;
+        }
+        // ...and insert the new one in its place
+        while( i > 0 && sorted[ i - 1] > x)
+        {
+          sorted[ i] = sorted[ i - 1];
+          --i;
+        }
+        sorted[ i] = x;
+        return sorted[ count / 2];
+    }
+
+    int16_t update( TFLFrame &frame) { return( frame.dist = update( frame.dist));}
+
+    int16_t value() const { return count ? sorted[ count / 2] : 0;}
+
+  private:
+    int16_t win[ N];          // samples in order of arrival
+    int16_t sorted[ N];       // the same samples in rising order
+    uint8_t count;            // samples in the window
+    uint8_t oldest;           // index in `win` of the oldest sample
+};
+
+// - - - -   Integer exponential moving average   - - - -
+// The average is kept with `S` extra fraction bits so that
+// small changes are not lost to rounding.
+template< uint8_t S>
+class TFLEma
+{
+    static_assert( S >= 1 && S <= 8, "TFLEma shift must be 1 to 8");
+
+  public:
+    TFLEma() { reset();}
+
+    void reset() { primed = false; acc = 0;}
+
+    int16_t update( int16_t x)
+    {
+        if( !primed)
+        {
+          acc = ( int32_t)x << S;     // start from the first sample
+          primed = true;
+        }
+        else acc += ( ( ( int32_t)x << S) - acc) >> S;
+        return value();
+    }
+
+    int16_t update( TFLFrame &frame) { return( frame.dist = update( frame.dist));}
+
+    // Rounded to the nearest whole unit
+    int16_t value() const { return ( acc + ( 1L << ( S - 1))) >> S;}
+
+  private:
+    int32_t acc;              // average with `S` fraction bits
+    bool primed;
+};
+
+// - - - -   Fixed-point 1-D Kalman filter   - - - -
+// The estimate is kept with 4 fraction bits, the variances in
+// cm^2 with 4 fraction bits, and the gain with 8 fraction bits.
+// `q` is the variance added to the estimate at each sample: a larger
+// value follows a moving target faster.  `r` is the variance of a
+// sample with a flux of 100.  The variance of a sample with any other
+// flux is taken as `r * 100 / flux`.
+class TFLKalman
+{
+  public:
+    TFLKalman( uint16_t q = TFL_KALMAN_Q, uint16_t r = TFL_KALMAN_R)
+        : q16( ( uint32_t)q << 4), r16( ( uint32_t)r << 4) { reset();}
+
+    void reset() { primed = false; x16 = 0; p16 = 0;}
+
+    int16_t update( int16_t z, int16_t flux)
+    {
+        if( !primed)
+        {
+          x16 = ( int32_t)z << 4;
+          p16 = r16;
+          primed = true;
+          return z;
+        }
+
+        // Predict: the distance may have moved by `q`
+        p16 += q16;
+        if( p16 > TFL_KALMAN_PMAX) p16 = TFL_KALMAN_PMAX;
+
+        // Measurement noise from the signal strength
+        uint16_t amp = ( flux > 0) ? ( uint16_t)flux : 1;
+        uint32_t rz = r16 * 100UL / amp;
+        if( rz == 0) rz = 1;
+
+        // Update: gain in 1/256 units
+        int32_t k = ( int32_t)( ( p16 << 8) / ( p16 + rz));
+        x16 += ( k * ( ( ( int32_t)z << 4) - x16)) >> 8;
+        p16 = ( p16 * ( uint32_t)( 256 - k)) >> 8;
+        return value();
+    }
+
+    int16_t update( TFLFrame &frame)
+    {
+        return( frame.dist = update( frame.dist, frame.flux));
+    }
+
+    // Rounded to the nearest centimeter
+    int16_t value() const { return ( x16 + 8) >> 4;}
+    // Variance of the estimate, in cm^2
+    uint16_t variance() const { return p16 >> 4;}
+
+  private:
+    // Largest variance, so that `p16 << 8` cannot overflow
+    static const uint32_t TFL_KALMAN_PMAX = 0x007FFFFFUL;
+
+    uint32_t q16;             // process noise, 4 fraction bits
+    uint32_t r16;             // noise at flux 100, 4 fraction bits
+    int32_t  x16;             // estimate, 4 fraction bits
+    uint32_t p16;             // variance of the estimate, 4 fraction bits
+    bool primed;
+};
+
+#endif  // TFLFILTER_H
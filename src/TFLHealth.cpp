@@ -0,0 +1,167 @@
+/* File Name: TFLHealth.cpp
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Watches the health of each device of a `TFLI2CArray`,
+ *            to find the TF-Luna sensors that are failing.
+ *
+ *  The reads during the grace time after a reset are not counted, as
+ *  a rebooting device does not answer.  A stale read says nothing of
+ *  the health of a device and is not counted either.
+ */
+
+#include <TFLHealth.h>
+
+// True if the status code means the device did not answer
+static bool isBusError( uint8_t status)
+{
+    return( status == TFL_I2CWRITE || status == TFL_I2CREAD ||
+            status == TFL_TIMEOUT);
+}
+
+// Move a rate in 1/65536 one step towards a hit or a miss
+static void average( uint16_t &q, bool hit)
+{
+    int32_t v = hit ? 0xFFFF : 0;
+    q = ( uint16_t)( q + ( v - q) / ( 1 << TFL_HEALTH_SHIFT));
+}
+
+static uint16_t perMille( uint16_t q)
+{
+    return ( uint16_t)( ( ( uint32_t)q * 1000 + 0x8000) >> 16);
+}
+
+// Constructor/Destructor
+TFLHealth::TFLHealth( TFLI2C &_tfl, TFLI2CArray &_array) : tfl( _tfl), array( _array)
+{
+    actions = 0;
+    memset( dev, 0, sizeof( dev));
+    memset( track, 0, sizeof( track));
+}
+TFLHealth::~TFLHealth(){}
+
+void TFLHealth::begin()
+{
+    tfl.Set_Err_Check( true);
+    for( uint8_t i = 0; i < TFL_MAX_DEVICES; ++i) clear( i);
+}
+
+void TFLHealth::setActions( uint8_t _actions)
+{
+    actions = _actions;
+}
+
+uint8_t TFLHealth::state( uint8_t idx)
+{
+    return ( idx < TFL_MAX_DEVICES) ? dev[ idx].state : TFL_HEALTH_GOOD;
+}
+
+// An index past the table passes back an empty, GOOD record
+const TFLDevHealth &TFLHealth::health( uint8_t idx)
+{
+    static const TFLDevHealth none = { TFL_HEALTH_GOOD, 0, 0, 0, 0, 0, 0};
+    return ( idx < TFL_MAX_DEVICES) ? dev[ idx] : none;
+}
+
+void TFLHealth::clear( uint8_t idx)
+{
+    if( idx >= TFL_MAX_DEVICES) return;
+    if( dev[ idx].state == TFL_HEALTH_DROPPED) array.setDropped( idx, false);
+    memset( &dev[ idx], 0, sizeof( dev[ idx]));
+    memset( &track[ idx], 0, sizeof( track[ idx]));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              CHECK
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+int8_t TFLHealth::update()
+{
+    int8_t i = array.update();
+    if( i >= 0) check( i);
+    return i;
+}
+
+void TFLHealth::check( uint8_t idx)
+{
+    if( idx >= array.count()) return;
+    TFLDevice &d = array.device( idx);
+    TFLDevHealth &h = dev[ idx];
+    Track &t = track[ idx];
+    uint32_t ms = millis();
+
+    if( h.state == TFL_HEALTH_DROPPED) return;
+    if( h.state == TFL_HEALTH_RESETTING)
+    {
+      if( ms - t.resetMs < TFL_HEALTH_GRACE_MS) return;
+      h.state = TFL_HEALTH_GOOD;
+    }
+    if( d.status == TFL_STALE) return;
+
+    bool bus = isBusError( d.status);
+    average( t.errQ, bus || d.status == TFL_DEVERR);
+    if( !bus)
+    {
+      average( t.weakQ, d.status == TFL_WEAK);
+
+      // Smooth the temperature as the rates, in 1/16 of 0.01 C
+      int32_t temp = ( int32_t)d.temp * 16;
+      if( !t.tempSeen)
+      {
+        t.tempSeen = true;
+        t.tempQ = temp;
+        t.tempMark = d.temp;
+        t.markMs = ms;
+      }
+      t.tempQ += ( temp - t.tempQ) / ( 1 << TFL_HEALTH_SHIFT);
+      h.temp = ( int16_t)( t.tempQ / 16);
+      if( ms - t.markMs >= TFL_HEALTH_TREND_MS)
+      {
+        h.trend = ( int16_t)( ( int32_t)( h.temp - t.tempMark) * 60000 / ( int32_t)( ms - t.markMs));
+        t.tempMark = h.temp;
+        t.markMs = ms;
+      }
+    }
+    h.errRate = perMille( t.errQ);
+    h.weakRate = perMille( t.weakQ);
+    ++h.reads;
+    judge( idx, ms);
+}
+
+// Grade the device, and reset or drop it if it is bad
+void TFLHealth::judge( uint8_t idx, uint32_t ms)
+{
+    TFLDevHealth &h = dev[ idx];
+    Track &t = track[ idx];
+    if( h.reads < TFL_HEALTH_MIN_READS)
+    {
+      h.state = TFL_HEALTH_GOOD;
+      return;
+    }
+
+    if( h.errRate >= TFL_HEALTH_BAD_ERR)
+    {
+      if( ( actions & TFL_HEALTH_RESET) && h.resets < TFL_HEALTH_RESETS)
+      {
+        tfl.Soft_Reset( array.device( idx).addr);
+        ++h.resets;
+        h.state = TFL_HEALTH_RESETTING;
+        h.reads = 0;
+        t.errQ = 0;
+        t.weakQ = 0;
+        t.resetMs = ms;
+      }
+      else if( actions & TFL_HEALTH_DROP)
+      {
+        array.setDropped( idx, true);
+        h.state = TFL_HEALTH_DROPPED;
+      }
+      else h.state = TFL_HEALTH_BAD;
+      return;
+    }
+
+    bool warn = h.errRate >= TFL_HEALTH_WARN_ERR ||
+                h.weakRate >= TFL_HEALTH_WARN_WEAK ||
+                h.temp >= TFL_HEALTH_WARN_TEMP ||
+                h.trend >= TFL_HEALTH_WARN_TREND;
+    h.state = warn ? TFL_HEALTH_WARN : TFL_HEALTH_GOOD;
+}
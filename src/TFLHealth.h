@@ -0,0 +1,132 @@
+/* File Name: TFLHealth.h
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Watches the health of each device of a `TFLI2CArray`,
+ *            to find the TF-Luna sensors that are failing.
+ *
+ *  A `TFLHealth` object reads the array the same way `update()` does.
+ *  After each read it looks at the status and temperature of the
+ *  device that was read, and keeps for each device:
+ *    - the error rate: reads that failed on the bus or with a device
+ *      error, `TFL_DEVERR`, in parts per thousand
+ *    - the weak rate: reads with too weak a signal, `TFL_WEAK`
+ *    - the temperature, smoothed, and its trend in 0.01 degree
+ *      Celsius a minute, over `TFL_HEALTH_TREND_MS`
+ *  The rates are moving averages over about `1 << TFL_HEALTH_SHIFT`
+ *  reads.  `begin()` turns on `Set_Err_Check`, so the error register
+ *  comes in the same burst as every frame.
+ *
+ *  Each device is then `TFL_HEALTH_GOOD`, or `TFL_HEALTH_WARN` when a
+ *  rate, the temperature or its trend passes a warning level, or
+ *  `TFL_HEALTH_BAD` when the error rate passes `TFL_HEALTH_BAD_ERR`.
+ *  With `TFL_HEALTH_RESET` set by `setActions`, a bad device is given
+ *  a `Soft_Reset` and a grace time to reboot, up to `TFL_HEALTH_RESETS`
+ *  times.  With `TFL_HEALTH_DROP`, a device still bad after that is
+ *  dropped from the schedule of the array, so that its timeouts do not
+ *  slow the other devices.  `clear( idx)` and `setDropped` bring it back.
+ *
+ *  Typical use:
+ *    TFLI2C tflI2C;
+ *    TFLI2CArray tflArray( tflI2C);
+ *    TFLHealth tflHealth( tflI2C, tflArray);
+ *    ...
+ *    tflArray.begin();
+ *    tflHealth.begin();
+ *    tflHealth.setActions( TFL_HEALTH_RESET | TFL_HEALTH_DROP);
+ *    ...
+ *    int8_t i = tflHealth.update();     // in place of `tflArray.update()`
+ *    if( tflHealth.state( i) != TFL_HEALTH_GOOD) ...
+ */
+
+#ifndef TFLHEALTH_H
+#define TFLHEALTH_H
+
+#include <TFLI2CArray.h>
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//      Definitions
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#define TFL_HEALTH_SHIFT        5   // rates average about 32 reads
+#define TFL_HEALTH_MIN_READS   32   // reads before a device is judged
+#define TFL_HEALTH_WARN_ERR    20   // error rate to warn, per mille
+#define TFL_HEALTH_BAD_ERR    250   // error rate of a bad device
+#define TFL_HEALTH_WARN_WEAK  500   // weak rate to warn, per mille
+#define TFL_HEALTH_WARN_TEMP 6000   // temperature to warn, 0.01 C
+#define TFL_HEALTH_WARN_TREND 100   // rise to warn, 0.01 C a minute
+#define TFL_HEALTH_TREND_MS 10000   // time over which the trend is taken
+#define TFL_HEALTH_RESETS       2   // resets before a device is dropped
+#define TFL_HEALTH_GRACE_MS  1000   // reboot time after a reset
+
+// Health of a device
+#define TFL_HEALTH_GOOD         0
+#define TFL_HEALTH_WARN         1   // degrading
+#define TFL_HEALTH_BAD          2   // failing
+#define TFL_HEALTH_RESETTING    3   // reset, rebooting
+#define TFL_HEALTH_DROPPED      4   // dropped from the schedule
+
+// Actions on a bad device
+#define TFL_HEALTH_RESET     0x01   // `Soft_Reset` a bad device
+#define TFL_HEALTH_DROP      0x02   // drop a device that stays bad
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                 OBJECT CLASS DEFINITIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct TFLDevHealth
+{
+    uint8_t  state;          // `TFL_HEALTH_*`
+    uint16_t errRate;        // bus and device errors, per mille
+    uint16_t weakRate;       // weak signal reads, per mille
+    int16_t  temp;           // smoothed temperature, 0.01 C
+    int16_t  trend;          // temperature change, 0.01 C a minute
+    uint32_t reads;          // reads since `begin`, `clear` or a reset
+    uint8_t  resets;         // resets made by the health check
+};
+
+class TFLHealth
+{
+  public:
+    TFLHealth( TFLI2C &tfl, TFLI2CArray &array);
+    ~TFLHealth();
+
+    // Turn on `Set_Err_Check` and clear the health of every device
+    void begin();
+    // `TFL_HEALTH_RESET` and `TFL_HEALTH_DROP` to act on bad devices
+    void setActions( uint8_t actions);
+
+    // Read the array with `update()` and check the device read.
+    // Returns its index, or -1 if none was due.
+    int8_t update();
+    // Check device `idx` after a read made elsewhere, such as
+    // `updateAll()` or `capture()` of the array
+    void check( uint8_t idx);
+
+    uint8_t state( uint8_t idx);
+    const TFLDevHealth &health( uint8_t idx);
+    // Forget the health of device `idx`, and take it back if it was dropped
+    void clear( uint8_t idx);
+
+  private:
+    struct Track
+    {
+        uint16_t errQ;       // error rate, 1/65536
+        uint16_t weakQ;      // weak rate, 1/65536
+        int32_t  tempQ;      // temperature << 4
+        int16_t  tempMark;   // temperature at `markMs`
+        uint32_t markMs;     // start of the trend period
+        uint32_t resetMs;    // time of the last reset
+        bool     tempSeen;   // a temperature was read
+    };
+
+    TFLI2C &tfl;
+    TFLI2CArray &array;
+    uint8_t actions;
+    TFLDevHealth dev[ TFL_MAX_DEVICES];
+    Track track[ TFL_MAX_DEVICES];
+
+    void judge( uint8_t idx, uint32_t ms);
+};
+
+#endif  // TFLHEALTH_H
@@ -0,0 +1,77 @@
+/* File Name: TFLHost.h
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: The few Arduino functions used by the TFLI2C library,
+ *            for builds without an Arduino core.
+ *
+ *  "TFLI2C.h" includes this file in place of "Arduino.h" and "Wire.h"
+ *  when `ARDUINO` is not defined, for example on a Linux host or under
+ *  ESP-IDF.  The library then has no Wire transport: give it another
+ *  `TFLBus` with `Set_Bus`.  The time functions use the POSIX monotonic
+ *  clock, and `Serial` prints to the standard output.
+ */
+
+#ifndef TFLHOST_H
+#define TFLHOST_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#if defined( __unix__) || defined( __APPLE__)
+  #include <sched.h>
+#endif
+
+// - - - -   Time   - - - -
+inline uint64_t tflHostMicros()
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts);
+    return ( uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+inline uint32_t micros() { return ( uint32_t)tflHostMicros();}
+inline uint32_t millis() { return ( uint32_t)( tflHostMicros() / 1000);}
+
+inline void delayMicroseconds( uint32_t us)
+{
+    struct timespec ts;
+    ts.tv_sec = us / 1000000UL;
+    ts.tv_nsec = ( long)( us % 1000000UL) * 1000L;
+    nanosleep( &ts, NULL);
+}
+
+inline void delay( uint32_t ms)
+{
+    while( ms >= 1000)
+    {
+      delayMicroseconds( 1000000UL);
+      ms -= 1000;
+    }
+    delayMicroseconds( ms * 1000UL);
+}
+
+inline void yield()
+{
+#if defined( __unix__) || defined( __APPLE__)
+    sched_yield();
+#endif
+}
+
+// - - - -   Print   - - - -
+#define DEC 10
+#define HEX 16
+
+struct TFLHostPrint
+{
+    void print( const char *s) { fputs( s, stdout);}
+    void print( long n, int base = DEC) { printf( ( base == HEX) ? "%lX" : "%ld", n);}
+    void println() { putchar( '\n');}
+    void println( const char *s) { puts( s);}
+};
+
+extern TFLHostPrint Serial;   // defined in "TFLI2C.cpp"
+
+#endif  // TFLHOST_H
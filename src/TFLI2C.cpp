@@ -7,6 +7,28 @@
               Changed TFL_DEFAULT_ADDR and TFL_DEFAULT_FPS
               to TFL_DEF_ADR and TFL_DEF_FPS in the header file.
               0.2.0 - Corrected (reversed) Enable/Disable commands
+              0.3.0 - `getData` reads the whole data frame in one
+              I2C burst instead of six single register reads.
+              Added `readRegs` and `writeRegs` to move a block of
+              registers in one transaction. The explicit commands
+              and `readReg`/`writeReg` are now built on them.
+              Added the asynchronous `startRead`/`poll` state machine.
+              Data frames are validated by configurable `TFLLimits`.
+              Added optional `TFL_STATS` instrumentation.
+              Added `Set_Bus_Clock` to negotiate a faster I2C clock.
+              Settings are cached in a per-device shadow, so reads are
+              served from the cache and unchanged writes are skipped.
+              Transactions can be time limited and report `TFL_TIMEOUT`.
+              A stuck bus is recovered with nine clocks and a STOP.
+              Transactions can hold a caller's bus lock, and the short
+              `getData` no longer keeps hidden `static` values.
+              Every transaction goes through a `TFLBus` transport.
+              The Wire transport `TFLWireBus` is the default, so no
+              call to `Set_Bus` is needed for `Wire`.
+              `getFrames` reads several devices through `readMulti`.
+              Added `probe` and a `readRegs` of several devices.
+              Added `Set_Err_Check` and the `TFL_DEVERR` status.
+              `poll` receives in the background where the transport can.
  * Described: Arduino Library for the Benewake TF-Luna Lidar sensor
               configured for the I2C interface
  *
@@ -20,6 +42,7 @@
       - dist : unsigned integer : distance measured by the device, in cm.
       - flux : unsigned integer : signal strength, quality or confidence
                If flux value too low, an error will occur.
+               The limits can be changed with `Set_Limits()`.
       - temp : unsigned integer : temperature of the chip in 0.01 degrees C
       - addr : unsigned byte : address of slave device.
       Returns true, if no error occurred.
@@ -27,14 +50,83 @@
          that can be displayed using 'printFrame()' function.
 
  * NOTE : If you only want to read distance, use getData( dist, addr)
+ * NOTE : To also read the device tick (timestamp) and error registers
+ *        in the same burst, use getData( dist, flux, temp, tick, addr)
+ *        or getData( dist, flux, temp, tick, err, addr)
+ * NOTE : To skip frames already read, keep the `tick` of the last
+ *        frame and use getFreshData( dist, flux, temp, tick, addr)
+ * NOTE : After `Set_Err_Check( true)` every frame read also takes the
+ *        tick and error registers, and a frame with a device error
+ *        fails with `TFL_DEVERR`
+ *
+ *  There is an asynchronous version of `getData` for sketches that
+ *  cannot afford to hold the CPU for a whole data frame exchange.
+ *  `startRead( addr, cb)` sends the register pointer and returns.
+ *  `poll()` then reads the frame and calls the optional callback.
+ *  `isReady()` is true until the frame is taken by `readResult()`.
  *
  *  There are several explicit commands
+ *
+ *  The setting registers of up to `TFL_SHADOW_SLOTS` devices are cached.
+ *  `Get_` commands for settings are then answered from the cache and
+ *  `Set_` commands that would not change a setting are not sent.  The
+ *  cache of a device is cleared by `Soft_Reset` and `Hard_Reset`, and
+ *  can be cleared with `Clear_Cache` if a device is changed elsewhere.
  */
 
 #include <TFLI2C.h>        //  TFLI2C library header
 
+#if !defined( ARDUINO)
+TFLHostPrint Serial;       //  `printStatus` output on a host
+#endif
+
+// Instrumentation hooks.  Without `TFL_STATS` they expand to nothing.
+#ifdef TFL_STATS
+  #define TFL_COUNT( tx, nb)    { stats.transactions += ( tx); stats.bytes += ( nb);}
+  #define TFL_COUNT_ERR( a, s)  countError( ( a), ( s))
+  #define TFL_TIME_START()      uint32_t tflStart = micros()
+  #define TFL_TIME_FRAME()      countFrame( stats, micros() - tflStart)
+static void countFrame( TFLStats &st, uint32_t us)
+{
+    if( st.frames == 0 || us < st.frameMin) st.frameMin = us;
+    if( us > st.frameMax) st.frameMax = us;
+    st.frameSum += us;
+    ++st.frames;
+}
+#else
+  #define TFL_COUNT( tx, nb)
+  #define TFL_COUNT_ERR( a, s)
+  #define TFL_TIME_START()
+  #define TFL_TIME_FRAME()
+#endif
+
 // Constructor/Destructor
-TFLI2C::TFLI2C(){}
+TFLI2C::TFLI2C()
+{
+  tfStatus = TFL_READY;
+  frameLen = 0;
+  burstLen = TFL_FRAME_TICK;
+  regReply = 0;
+  asyncState = TFL_ASYNC_IDLE;
+  asyncAddr = TFL_DEF_ADR;
+  asyncLen = TFL_FRAME_LEN;
+  asyncFail = TFL_READY;
+  asyncCb = NULL;
+  memset( dataArray, 0, sizeof( dataArray));
+  memset( &clockProbe, 0, sizeof( clockProbe));
+  Clear_Cache();
+#if defined( ARDUINO)
+  _Bus = &wire;
+#else
+  _Bus = NULL;             // no bus until `Set_Bus`
+#endif
+  busLock = NULL;
+  busUnlock = NULL;
+  lockCtx = NULL;
+#ifdef TFL_STATS
+  clearStats();
+#endif
+}
 TFLI2C::~TFLI2C(){}
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -45,56 +137,409 @@ bool TFLI2C::getData( int16_t &dist, int16_t &flux, int16_t &temp, uint8_t addr)
     tfStatus = TFL_READY;    // clear status of any error condition
 
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-    // Step 1 - Use the `Wire` function `readReg` to fill the six byte
-    // `dataArray` from the contiguous sequence of registers `TFL_DIST_LO`
-    // to `TFL_TEMP_HI` that declared in the header file 'TFLI2C.h`.
+    // Step 1 - Use `readFrame` to fill the six byte `dataArray` from the
+    // contiguous sequence of registers `TFL_DIST_LO` to `TFL_TEMP_HI`
+    // that are declared in the header file 'TFLI2C.h`.
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-    for (uint8_t reg = TFL_DIST_LO; reg <= TFL_TEMP_HI; reg++)
-    {
-      if( !readReg( reg, addr)) return false;
-          else dataArray[ reg] = regReply;
-    }
+    // With `Set_Err_Check` the burst runs on to the error register.
+    if( !readFrame( ( burstLen == TFL_FRAME_ERR) ? TFL_FRAME_ERR : TFL_FRAME_LEN, addr)) return false;
 
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     // Step 2 - Shift data from read array into the three variables
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    return decodeFrame( dist, flux, temp);
+}
+
+// Get data plus the device tick (timestamp) in milliseconds
+bool TFLI2C::getData( int16_t &dist, int16_t &flux, int16_t &temp,
+                      uint16_t &tick, uint8_t addr)
+{
+    tfStatus = TFL_READY;
+    if( !readFrame( burstLen, addr)) return false;
+    tick = dataArray[ 6] + ( dataArray[ 7] << 8);
+    return decodeFrame( dist, flux, temp);
+}
+
+// Get data plus the device tick and the error register
+bool TFLI2C::getData( int16_t &dist, int16_t &flux, int16_t &temp,
+                      uint16_t &tick, uint16_t &err, uint8_t addr)
+{
+    tfStatus = TFL_READY;
+    if( !readFrame( TFL_FRAME_ERR, addr)) return false;
+    tick = dataArray[ 6] + ( dataArray[ 7] << 8);
+    err  = dataArray[ 8] + ( dataArray[ 9] << 8);
+    return decodeFrame( dist, flux, temp);
+}
+
+// Get data only if a new frame has arrived since the frame
+// stamped `tick`.  The tick is read in the same burst as the
+// data.  If it has not moved on, the status is set to `TFL_STALE`
+// and the data is not decoded.  Otherwise `tick` is updated.
+bool TFLI2C::getFreshData( int16_t &dist, int16_t &flux, int16_t &temp,
+                           uint16_t &tick, uint8_t addr)
+{
+    tfStatus = TFL_READY;
+    if( !readFrame( burstLen, addr)) return false;
+    uint16_t newTick = dataArray[ 6] + ( dataArray[ 7] << 8);
+    if( newTick == tick)
+    {
+      tfStatus = TFL_STALE;
+      return false;
+    }
+    tick = newTick;
+    return decodeFrame( dist, flux, temp);
+}
+
+// Read the data and tick in one burst into a local buffer, so that
+// several tasks may call this on one object at the same time.  The
+// `limits` are only read.  `frame.status` is the status of the read.
+bool TFLI2C::getData( TFLFrame &frame, uint8_t addr)
+{
+    uint8_t buf[ TFL_FRAME_ERR];
+    frame.addr = addr;
+    frame.status = tflStatus( readBus( TFL_DIST_LO, buf, burstLen, addr));
+    if( !frame.ok()) return false;
+    return decodeFrame( buf, frame);
+}
+
+bool TFLI2C::decodeFrame( const uint8_t buf[], TFLFrame &frame) const
+{
+    frame.dist = buf[ 0] + ( buf[ 1] << 8);
+    frame.flux = buf[ 2] + ( buf[ 3] << 8);
+    frame.temp = buf[ 4] + ( buf[ 5] << 8);
+    frame.tick = buf[ 6] + ( buf[ 7] << 8);
+    if( burstLen >= TFL_FRAME_ERR && ( buf[ 8] | buf[ 9])) frame.status = TFLStatus::DevError;
+    else frame.status = tflStatus( limits.evaluate( frame.dist, frame.flux));
+    return frame.ok();
+}
+
+// Read a frame and pass it back, status and all.  For example:
+//   TFLFrame f = tflI2C.getFrame( addr);
+//   if( f.ok()) use( f.dist);
+//   else if( f.status == TFLStatus::Weak) ...
+// The data of a failed read is zero.
+TFLFrame TFLI2C::getFrame( uint8_t addr)
+{
+    TFLFrame frame = TFLFrame();
+    getData( frame, addr);
+    return frame;
+}
+
+// Shift the first six bytes of `dataArray` into the three
+// variables and evaluate them against the `limits`.
+bool TFLI2C::decodeFrame( int16_t &dist, int16_t &flux, int16_t &temp)
+{
     dist = dataArray[ 0] + ( dataArray[ 1] << 8);
     flux = dataArray[ 2] + ( dataArray[ 3] << 8);
     temp = dataArray[ 4] + ( dataArray[ 5] << 8);
 
-/*
-    // Convert temperature from hundredths
-    // of a degree to a whole number
-    temp = int16_t( temp / 100);
-    // Then convert Celsius to degrees Fahrenheit
-    temp = uint8_t( temp * 9 / 5) + 32;
-*/
+    // Values are passed back as read: distance in centimeters
+    // and temperature in hundredths of a degree Celsius.  For other
+    // units use the fixed-point conversions in 'TFLUnits.h`.
 
     // - - Evaluate Abnormal Data Values - -
-    // Signal strength <= 100
-    if( flux < (int16_t)100)
+    // A device error, if it was read, comes first
+    if( frameLen >= TFL_FRAME_ERR && ( dataArray[ 8] | dataArray[ 9])) tfStatus = TFL_DEVERR;
+    else tfStatus = limits.evaluate( dist, flux);
+    return( tfStatus == TFL_READY);
+}
+
+// Get Data short version
+bool TFLI2C::getData( int16_t &dist, uint8_t addr)
+{
+  int16_t flux, temp;
+  return getData( dist, flux, temp, addr);
+}
+
+// Read data and tick of several devices, `TFL_MULTI_DEVICES` at a
+// time, through the `readMulti` of the transport.  A transport that
+// can queue transactions, such as `TFLLinuxBus`, then makes one call
+// for all of them.  Reentrant, as `getData( frame, addr)`.
+uint8_t TFLI2C::getFrames( const uint8_t addr[], uint8_t n, TFLFrame out[])
+{
+    uint8_t buf[ TFL_MULTI_DEVICES * TFL_FRAME_ERR];
+    uint8_t status[ TFL_MULTI_DEVICES];
+    uint8_t good = 0;
+
+    for( uint8_t first = 0; first < n; first += TFL_MULTI_DEVICES)
+    {
+      uint8_t k = n - first;
+      if( k > TFL_MULTI_DEVICES) k = TFL_MULTI_DEVICES;
+      readRegs( addr + first, k, TFL_DIST_LO, buf, burstLen, status);
+      for( uint8_t i = 0; i < k; ++i)
+      {
+        TFLFrame &f = out[ first + i];
+        f.addr = addr[ first + i];
+        f.status = tflStatus( status[ i]);
+        if( f.ok() && decodeFrame( buf + i * burstLen, f)) ++good;
+      }
+    }
+    return good;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//          READ A BATCH OF FRAMES
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Fill the caller's buffer with `n` new frames, one per device
+// frame, for a calibration capture.  Each read takes data and tick
+// in one burst and a frame whose tick has not moved on is skipped.
+// After a new frame the device is left alone for 7/8 of its frame
+// period, and then polled every 1/32 of it, so the bus is not kept
+// busy with stale reads.  A failed read waits `TFL_BATCH_RETRY_US`.  Frames that
+// fail the limits are counted and skipped unless `TFL_BATCH_KEEP_BAD`
+// is set.  The batch ends early if no new frame arrives within
+// `opts.waitMs`; the status is then `TFL_STALE` or that of the failed read.
+size_t TFLI2C::readBatch( uint8_t addr, TFLFrame *out, size_t n,
+                          const TFLBatchOpts &opts, TFLBatchStats *stats)
+{
+    return batch( addr, out, NULL, NULL, n, opts, stats);
+}
+
+// The same, into separate arrays that can be processed as vectors
+size_t TFLI2C::readBatch( uint8_t addr, int16_t *dist, int16_t *flux, size_t n,
+                          const TFLBatchOpts &opts, TFLBatchStats *stats)
+{
+    return batch( addr, NULL, dist, flux, n, opts, stats);
+}
+
+size_t TFLI2C::batch( uint8_t addr, TFLFrame *out, int16_t *dist, int16_t *flux,
+                      size_t n, const TFLBatchOpts &opts, TFLBatchStats *stats)
+{
+    TFLBatchStats st;
+    memset( &st, 0, sizeof( st));
+    uint32_t start = micros();
+
+    uint32_t paceUs = 0;
+    uint16_t fps;
+    if( !( opts.flags & TFL_BATCH_NO_PACE) && Get_Frame_Rate( fps, addr) && fps > 0)
+    {
+      paceUs = 1000000UL / fps / 8 * 7;
+    }
+
+    uint8_t cause = TFL_STALE;      // why the batch ended early
+    uint16_t tick = 0;
+    bool first = true;
+    uint32_t lastNew = start;       // time of the last new frame
+    uint32_t nextRead = start;
+    size_t got = 0;
+    TFLFrame f;
+
+    while( got < n)
+    {
+      uint32_t now = micros();
+      if( now - lastNew >= opts.waitMs * 1000UL) break;
+      if( ( int32_t)( now - nextRead) < 0)
+      {
+        yield();
+        continue;
+      }
+
+      // A frame that was not decoded has no data or tick to use
+      getData( f, addr);
+      if( !tflDecoded( ( uint8_t)f.status))
+      {
+        ++st.busErrors;
+        cause = ( uint8_t)f.status;
+        nextRead = now + TFL_BATCH_RETRY_US;
+        continue;
+      }
+      cause = TFL_STALE;
+      if( !first && f.tick == tick)
+      {
+        ++st.stale;
+        nextRead = now + paceUs / 28;
+        continue;
+      }
+      first = false;
+      tick = f.tick;
+      lastNew = now;
+      nextRead = now + paceUs;
+
+      if( !f.ok() && !( opts.flags & TFL_BATCH_KEEP_BAD))
+      {
+        ++st.rejects;
+        continue;
+      }
+      if( out) out[ got] = f;
+      else
+      {
+        dist[ got] = f.dist;
+        if( flux) flux[ got] = f.flux;
+      }
+      ++got;
+    }
+
+    tfStatus = ( got == n) ? TFL_READY : cause;
+    st.frames = got;
+    st.elapsedUs = micros() - start;
+    if( stats) *stats = st;
+    return got;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//          GET DATA ASYNCHRONOUSLY FROM THE DEVICE
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+// The data frame read is split into its two bus phases so that
+// each call holds the CPU for only one of them.  If the transport
+// has `startReceive`, such as `TFLIdfBus` with `setAsync`, the frame
+// is received in the background and the CPU is free while it is on
+// the wire.  Arduino `Wire` has no portable non-blocking transfer,
+// so there each phase uses the same blocking transaction as
+// `readRegs`.  The device keeps its register pointer between the
+// phases, so no other command should be sent to the same device
+// until the read is complete.  The bus lock is held for each phase,
+// not between them, so another task may use the bus, but not this
+// device, meanwhile.  A background receive holds the lock until a
+// `poll` finds it done, so `poll` must be called from the same task.
+
+// Phase 1 - Send the register pointer `TFL_DIST_LO` and return.
+// Returns false if a read is already pending or the write failed.
+bool TFLI2C::startRead( uint8_t addr, TFLCallback cb, uint8_t len)
+{
+    if( asyncState == TFL_ASYNC_ADDR || asyncState == TFL_ASYNC_RECV)
     {
-      tfStatus = TFL_WEAK;
+      tfStatus = TFL_INVALID;
       return false;
     }
-    // Signal Strength saturation
-    else if( flux == (int16_t)0xFFFF)
+    if( len < TFL_FRAME_LEN || len > TFL_FRAME_ERR)
     {
-      tfStatus = TFL_STRONG;
+      tfStatus = TFL_I2CLENGTH;
       return false;
     }
+    asyncState = TFL_ASYNC_IDLE;
+    asyncAddr = addr;
+    asyncLen = len;
+    asyncCb = cb;
+    asyncFail = TFL_READY;
+    tfStatus = TFL_READY;
+
+    if( !_Bus) tfStatus = TFL_INVALID;
     else
     {
-      tfStatus = TFL_READY;
-      return true;
+      busTake();
+      TFL_COUNT( 1, 1);
+      tfStatus = _Bus->writeRegs( addr, TFL_DIST_LO, NULL, 0);
+      if( tfStatus != TFL_READY) busFailed( addr, tfStatus);
+      busGive();
     }
+    if( tfStatus != TFL_READY)    // If write error...
+    {
+      asyncFail = tfStatus;
+      if( asyncCb) asyncCb( asyncAddr, tfStatus);
+      return false;
+    }
+    asyncState = TFL_ASYNC_ADDR;
+    return true;
 }
 
-// Get Data short version
-bool TFLI2C::getData( int16_t &dist, uint8_t addr)
+// Phase 2 - Read the frame into `dataArray` and call the callback.
+// Returns true once a frame is ready to be taken by `readResult`.
+// A receive left to the transport returns false until it is done.
+bool TFLI2C::poll()
 {
-  static int16_t flux, temp;
-  return getData( dist, flux, temp, addr);
+    if( asyncState == TFL_ASYNC_RECV)
+    {
+      uint8_t status;
+      if( !_Bus->receiveDone( status)) return false;
+      tfStatus = status;
+      return endRead();
+    }
+    if( asyncState != TFL_ASYNC_ADDR) return( asyncState == TFL_ASYNC_READY);
+
+    frameLen = 0;
+    TFL_COUNT( 1, asyncLen);
+    busTake();
+    if( _Bus->startReceive( asyncAddr, dataArray, asyncLen) == TFL_READY)
+    {
+      asyncState = TFL_ASYNC_RECV;
+      return false;
+    }
+    tfStatus = _Bus->receive( asyncAddr, dataArray, asyncLen);
+    return endRead();
+}
+
+// Keep the frame or count the failure, release the
+// bus and call the callback
+bool TFLI2C::endRead()
+{
+    asyncState = TFL_ASYNC_IDLE;
+    if( tfStatus == TFL_READY)
+    {
+      frameLen = asyncLen;
+      asyncState = TFL_ASYNC_READY;
+    }
+    else
+    {
+      asyncFail = tfStatus;
+      busFailed( asyncAddr, tfStatus);
+    }
+    busGive();
+    if( asyncCb) asyncCb( asyncAddr, tfStatus);
+    return( asyncState == TFL_ASYNC_READY);
+}
+
+bool TFLI2C::isReady()
+{
+    return( asyncState == TFL_ASYNC_READY);
+}
+
+// Take the frame read by `poll` into the three variables.
+// Returns false if no frame is ready or the data is abnormal.
+bool TFLI2C::readResult( int16_t &dist, int16_t &flux, int16_t &temp)
+{
+    if( asyncState != TFL_ASYNC_READY)
+    {
+      tfStatus = TFL_INVALID;
+      return false;
+    }
+    asyncState = TFL_ASYNC_IDLE;
+    return decodeFrame( dist, flux, temp);
+}
+
+// Take the frame and device tick read by `poll`.
+// The read must have been started with `len` >= `TFL_FRAME_TICK`.
+bool TFLI2C::readResult( int16_t &dist, int16_t &flux, int16_t &temp,
+                         uint16_t &tick)
+{
+    if( asyncState != TFL_ASYNC_READY)
+    {
+      tfStatus = TFL_INVALID;
+      return false;
+    }
+    if( frameLen < TFL_FRAME_TICK)
+    {
+      asyncState = TFL_ASYNC_IDLE;
+      tfStatus = TFL_I2CLENGTH;
+      return false;
+    }
+    tick = dataArray[ 6] + ( dataArray[ 7] << 8);
+    return readResult( dist, flux, temp);
+}
+
+// Take the frame read by `poll` into a `TFLFrame` record,
+// for example to `push` it into a `TFLRing`.  The record keeps
+// the device address and status even if the data is abnormal.
+// `tick` is zero unless the read was started with `TFL_FRAME_TICK`.
+// With no frame ready the data is zero, and the status is that of
+// the read that failed, or `TFL_INVALID` if none did.
+bool TFLI2C::readResult( TFLFrame &frame)
+{
+    frame = TFLFrame();
+    frame.addr = asyncAddr;
+    if( asyncState != TFL_ASYNC_READY)
+    {
+      tfStatus = asyncFail ? asyncFail : TFL_INVALID;
+      frame.status = tflStatus( tfStatus);
+      return false;
+    }
+    bool ok;
+    if( frameLen >= TFL_FRAME_TICK)
+    {
+      ok = readResult( frame.dist, frame.flux, frame.temp, frame.tick);
+    }
+    else ok = readResult( frame.dist, frame.flux, frame.temp);
+    frame.status = tflStatus( tfStatus);
+    return ok;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -105,15 +550,9 @@ bool TFLI2C::getData( int16_t &dist, uint8_t addr)
 //  Pass back time as an unsigned 16-bit variable
 bool TFLI2C::Get_Time( uint16_t &tim, uint8_t adr)
 {
-    // Recast the address of the unsigned integer `tim`
-    // as a pointer to an unsigned byte `p_tim`...
-    uint8_t * p_tim = (uint8_t *) &tim;
-
-    // ... then address the pointer as an array.
-    if( !readReg( TFL_TICK_LO, adr)) return false;
-        else p_tim[ 0] = regReply;  // Read into `tim` array
-    if( !readReg( TFL_TICK_HI, adr)) return false;
-        else p_tim[ 1] = regReply;  // Read into `tim` array
+    uint8_t buf[ 2];
+    if( !readRegs( TFL_TICK_LO, buf, 2, adr)) return false;
+    tim = buf[ 0] + ( buf[ 1] << 8);
     return true;
 }
 
@@ -124,12 +563,7 @@ bool TFLI2C::Get_Time( uint16_t &tim, uint8_t adr)
 // sketch decays to the array pointer `p_cod`.
 bool TFLI2C::Get_Prod_Code( uint8_t * p_cod, uint8_t adr)
 {
-   for (uint8_t i = 0; i < 14; ++i)
-    {
-      if( !readReg( ( 0x10 + i), adr)) return false;
-        else p_cod[ i] = regReply;  // Read into product code array
-    }
-    return true;
+    return( readRegs( TFL_PROD_CODE, p_cod, TFL_PROD_LEN, adr));
 }
 
 //  = = = =    GET FIRMWARE VERSION   = = = =
@@ -137,12 +571,7 @@ bool TFLI2C::Get_Prod_Code( uint8_t * p_cod, uint8_t adr)
 // example sketch decays to the array pointer `p_ver`.
 bool TFLI2C::Get_Firmware_Version( uint8_t * p_ver, uint8_t adr)
 {
-    for (uint8_t i = 0; i < 3; ++i)
-    {
-      if( !readReg( ( 0x0A + i), adr)) return false;
-        else p_ver[ i] = regReply;  // Read into version array
-    }
-    return true;
+    return( readRegs( TFL_VER_REV, p_ver, 3, adr));
 }
 
 //  = = = = =    SAVE SETTINGS   = = = = =
@@ -154,6 +583,7 @@ bool TFLI2C::Save_Settings( uint8_t adr)
 //  = = = =   SOFT (SYSTEM) RESET   = = = =
 bool TFLI2C::Soft_Reset( uint8_t adr)
 {
+    Clear_Cache( adr);
     return( writeReg( TFL_SOFT_RESET, adr, 2));
 }
 
@@ -161,48 +591,51 @@ bool TFLI2C::Soft_Reset( uint8_t adr)
 // Range: 0x08, 0x77. Must reboot to take effect.
 bool TFLI2C::Set_I2C_Addr( uint8_t adrNew, uint8_t adr)
 {
-    return( writeReg( TFL_SET_I2C_ADDR, adr, adrNew));
+    return( writeCfg( TFL_SET_I2C_ADDR, &adrNew, 1, adr));
 }
 
 //  = = = = =   SET ENABLE   = = = = =
 bool TFLI2C::Set_Enable( uint8_t adr)
 {
-    return( writeReg( TFL_DISABLE, adr, 1));
+    uint8_t val = 1;
+    return( writeCfg( TFL_DISABLE, &val, 1, adr));
 }
 
 //  = = = = =   SET DISABLE   = = = = =
 bool TFLI2C::Set_Disable( uint8_t adr)
 {
-    return( writeReg( TFL_DISABLE, adr, 0));
+    uint8_t val = 0;
+    return( writeCfg( TFL_DISABLE, &val, 1, adr));
+}
+
+//  = = = = =   GET ENABLE   = = = = =
+bool TFLI2C::Get_Enable( uint8_t &enable, uint8_t adr)
+{
+    return( readCfg( TFL_DISABLE, &enable, 1, adr));
 }
 
 //  = = = = = =    SET FRAME RATE   = = = = = =
 bool TFLI2C::Set_Frame_Rate( uint16_t &frm, uint8_t adr)
 {
-    // Recast the address of the unsigned integer `frm`
-    // as a pointer to an unsigned byte `p_frm` ...
-    uint8_t * p_frm = (uint8_t *) &frm;
-
-    // ... then address the pointer as an array.
-    if( !writeReg( ( TFL_FPS_LO), adr, p_frm[ 0])) return false;
-    if( !writeReg( ( TFL_FPS_HI), adr, p_frm[ 1])) return false;
-    return true;
+    // Split the unsigned integer `frm` into lo and hi bytes
+    // and write both registers in one transaction.
+    uint8_t buf[ 2] = { ( uint8_t)frm, ( uint8_t)( frm >> 8)};
+    return( writeCfg( TFL_FPS_LO, buf, 2, adr));
 }
 
 //  = = = = = =    GET FRAME RATE   = = = = = =
 bool TFLI2C::Get_Frame_Rate( uint16_t &frm, uint8_t adr)
 {
-    uint8_t * p_frm = (uint8_t *) &frm;
-    if( !readReg( TFL_FPS_LO, adr)) return false;
-        else p_frm[ 0] = regReply;  // Read into `frm` array
-    if( !readReg( TFL_FPS_HI, adr)) return false;
-        else p_frm[ 1] = regReply;  // Read into `frm` array
+    uint8_t buf[ 2];
+    if( !readCfg( TFL_FPS_LO, buf, 2, adr)) return false;
+    frm = buf[ 0] + ( buf[ 1] << 8);
     return true;
 }
 
 //  = = = =   HARD RESET to Factory Defaults  = = = =
 bool TFLI2C::Hard_Reset( uint8_t adr)
 {
+    Clear_Cache( adr);
     return( writeReg( TFL_HARD_RESET, adr, 1));
 }
 
@@ -210,14 +643,23 @@ bool TFLI2C::Hard_Reset( uint8_t adr)
 // Sample LiDAR chip continuously at Frame Rate
 bool TFLI2C::Set_Cont_Mode( uint8_t adr)
 {
-    return( writeReg( TFL_SET_TRIG_MODE, adr, 0));
+    uint8_t val = 0;
+    return( writeCfg( TFL_SET_TRIG_MODE, &val, 1, adr));
 }
 
 //  = = = = = =   SET TRIGGER MODE   = = = = = =
 // Device will sample only once when triggered
 bool TFLI2C::Set_Trig_Mode( uint8_t adr)
 {
-    return( writeReg( TFL_SET_TRIG_MODE, adr, 1));
+    uint8_t val = 1;
+    return( writeCfg( TFL_SET_TRIG_MODE, &val, 1, adr));
+}
+
+//  = = = = = =   GET TRIGGER MODE   = = = = = =
+// Pass back 1 if in trigger mode, 0 if continuous
+bool TFLI2C::Get_Trig_Mode( uint8_t &trig, uint8_t adr)
+{
+    return( readCfg( TFL_SET_TRIG_MODE, &trig, 1, adr));
 }
 
 //  = = = = = =   SET TRIGGER   = = = = = =
@@ -226,51 +668,600 @@ bool TFLI2C::Set_Trigger( uint8_t adr)
 {
     return( writeReg( TFL_TRIGGER, adr, 1));
 }
+
+//  = = = = = =   SET LOW POWER MODE   = = = = = =
+// Use with the low power frame-rates `FPS_1` to `FPS_10`
+bool TFLI2C::Set_Lo_Power( uint8_t adr)
+{
+    uint8_t val = 1;
+    return( writeCfg( TFL_SET_LO_PWR, &val, 1, adr));
+}
+
+//  = = = = = =   SET NORMAL POWER MODE   = = = = = =
+bool TFLI2C::Set_Normal_Power( uint8_t adr)
+{
+    uint8_t val = 0;
+    return( writeCfg( TFL_SET_LO_PWR, &val, 1, adr));
+}
+
+//  = = = = = =   GET LOW POWER MODE   = = = = = =
+// Pass back 1 if in low power mode, 0 if normal
+bool TFLI2C::Get_Lo_Power( uint8_t &lopwr, uint8_t adr)
+{
+    return( readCfg( TFL_SET_LO_PWR, &lopwr, 1, adr));
+}
 //
 // = = = = = = = = = = = = = = = = = = = = = = = =
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 //       READ OR WRITE A GIVEN REGISTER OF THE SLAVE DEVICE
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+#if defined( ARDUINO)
 void TFLI2C::Set_Bus( TwoWire *bus)
 {
-  _Wire = bus;
+  wire.setWire( *bus);
+  _Bus = &wire;
+}
+#endif
+
+void TFLI2C::Set_Bus( TFLBus *bus)
+{
+  _Bus = bus;
+}
+
+TFLBus *TFLI2C::Get_Bus()
+{
+  return _Bus;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                 CONFIGURATION SHADOW
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TFLI2C::Clear_Cache( uint8_t adr)
+{
+    if( adr == 0)
+    {
+      memset( shadow, 0, sizeof( shadow));
+      shadowNext = 0;
+      return;
+    }
+    TFLShadow *sh = shadowFor( adr, false);
+    if( sh) sh->valid = 0;
+}
+
+// Find the shadow of device `addr`.  If it has none and `make`
+// is true, take a free slot or else reuse the oldest slot.
+TFLShadow *TFLI2C::shadowFor( uint8_t addr, bool make)
+{
+    TFLShadow *free = NULL;
+    for( uint8_t i = 0; i < TFL_SHADOW_SLOTS; ++i)
+    {
+      if( shadow[ i].addr == addr) return &shadow[ i];
+      if( shadow[ i].addr == 0 && !free) free = &shadow[ i];
+    }
+    if( !make) return NULL;
+    if( !free)
+    {
+      free = &shadow[ shadowNext];
+      shadowNext = ( shadowNext + 1) % TFL_SHADOW_SLOTS;
+    }
+    free->addr = addr;
+    free->valid = 0;
+    return free;
+}
+
+// Bits of the shadow `valid` mask of `len` registers from `nmbr`
+static uint16_t shadowBits( uint8_t nmbr, uint8_t len)
+{
+    return( ( ( 1U << len) - 1) << ( nmbr - TFL_SHADOW_FIRST));
+}
+
+// Read setting registers from the shadow if they are all known,
+// else read them from the device and keep them in the shadow.
+bool TFLI2C::readCfg( uint8_t nmbr, uint8_t buf[], uint8_t len, uint8_t addr)
+{
+    uint16_t bits = shadowBits( nmbr, len);
+    TFLShadow *sh = shadowFor( addr, true);
+    uint8_t *reg = &sh->reg[ nmbr - TFL_SHADOW_FIRST];
+
+    if( ( sh->valid & bits) == bits)
+    {
+      memcpy( buf, reg, len);
+      tfStatus = TFL_READY;
+      return true;
+    }
+    if( !readRegs( nmbr, buf, len, addr)) return false;
+    memcpy( reg, buf, len);
+    sh->valid |= bits & TFL_SHADOW_MASK;
+    return true;
+}
+
+// Write setting registers unless the shadow shows that the
+// device already holds the same values.  Keep what was written.
+bool TFLI2C::writeCfg( uint8_t nmbr, const uint8_t buf[], uint8_t len, uint8_t addr)
+{
+    uint16_t bits = shadowBits( nmbr, len);
+    TFLShadow *sh = shadowFor( addr, true);
+    uint8_t *reg = &sh->reg[ nmbr - TFL_SHADOW_FIRST];
+
+    if( ( sh->valid & bits) == bits && memcmp( reg, buf, len) == 0)
+    {
+      tfStatus = TFL_READY;
+      return true;
+    }
+    if( !writeRegs( nmbr, buf, len, addr))
+    {
+      sh->valid &= ~bits;      // the device may hold either value
+      return false;
+    }
+    memcpy( reg, buf, len);
+    sh->valid |= bits & TFL_SHADOW_MASK;
+    return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                 I2C CLOCK NEGOTIATION
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Read the firmware version and production code at the standard
+// 100kHz clock as a reference.  Then step the clock up through
+// 400kHz (Fast-mode) and 1MHz (Fast-mode Plus), up to `maxClock`.
+// At each step read the same registers `probes` times and compare
+// them to the reference.  Stop at the first step with any error and
+// settle on the fastest clock that read without error.  Every device
+// and the wiring of the bus must support the clock, so with several
+// devices call this for each one and keep the slowest result.
+// Returns the clock settled on, or 0 if the device did not answer
+// at 100kHz.  The error counts are kept by `Get_Clock_Probe()`.
+uint32_t TFLI2C::Set_Bus_Clock( uint8_t adr, uint32_t maxClock, uint16_t probes)
+{
+    static const uint32_t steps[ TFL_CLOCK_STEPS] = { 100000UL, 400000UL, 1000000UL};
+    uint8_t refVer[ 3], refCod[ 14];
+    uint8_t ver[ 3], cod[ 14];
+
+    memset( &clockProbe, 0, sizeof( clockProbe));
+    clockProbe.probes = probes;
+
+    if( !busClock( steps[ 0]))
+    {
+      tfStatus = TFL_INVALID;       // the bus has no clock control
+      return 0;
+    }
+    clockProbe.clock[ 0] = steps[ 0];
+    if( !Get_Firmware_Version( refVer, adr) || !Get_Prod_Code( refCod, adr))
+    {
+      clockProbe.errors[ 0] = 1;
+      return 0;
+    }
+    clockProbe.chosen = steps[ 0];
+
+    for( uint8_t s = 1; s < TFL_CLOCK_STEPS && steps[ s] <= maxClock; ++s)
+    {
+      if( !busClock( steps[ s])) break;
+      clockProbe.clock[ s] = steps[ s];
+      for( uint16_t i = 0; i < probes; ++i)
+      {
+        if( !Get_Firmware_Version( ver, adr) || !Get_Prod_Code( cod, adr) ||
+            memcmp( ver, refVer, 3) != 0 || memcmp( cod, refCod, 14) != 0)
+        {
+          ++clockProbe.errors[ s];
+        }
+      }
+      if( clockProbe.errors[ s] != 0) break;
+      clockProbe.chosen = steps[ s];
+    }
+
+    busClock( clockProbe.chosen);
+    tfStatus = TFL_READY;
+    return clockProbe.chosen;
+}
+
+bool TFLI2C::busClock( uint32_t hz)
+{
+    if( !_Bus) return false;
+    busTake();
+    bool ok = _Bus->setClock( hz);
+    busGive();
+    return ok;
+}
+
+const TFLClockProbe &TFLI2C::Get_Clock_Probe()
+{
+    return clockProbe;
 }
 
 bool TFLI2C::readReg( uint8_t nmbr, uint8_t addr)
 {
-  (*_Wire).beginTransmission( addr);
-  (*_Wire).write( nmbr);
+  return( readRegs( nmbr, &regReply, 1, addr));
+}
+
+bool TFLI2C::writeReg( uint8_t nmbr, uint8_t addr, uint8_t data)
+{
+  return( writeRegs( nmbr, &data, 1, addr));
+}
+
+// Read `len` contiguous registers, starting from register `nmbr`,
+// into `buf`. The device auto-increments its register pointer so
+// the whole block costs only one write and one read transaction.
+bool TFLI2C::readRegs( uint8_t nmbr, uint8_t buf[], uint8_t len, uint8_t addr)
+{
+  uint8_t status = readBus( nmbr, buf, len, addr);
+  if( status == TFL_READY) return true;
+  tfStatus = status;                // set status code...
+  return false;                     // and return `false`.
+}
+
+// The same read as one whole transaction under the bus lock
+uint8_t TFLI2C::readBus( uint8_t nmbr, uint8_t buf[], uint8_t len, uint8_t addr)
+{
+  if( !_Bus) return TFL_INVALID;
+  if( len == 0 || len > _Bus->maxLength()) return TFL_I2CLENGTH;  // too long for the bus
 
-  if( (*_Wire).endTransmission() != 0)  // If write error...
+  busTake();
+  TFL_COUNT( 2, 1 + len);           // register write and read
+  uint8_t status = _Bus->readRegs( addr, nmbr, buf, len);
+  if( status != TFL_READY) busFailed( addr, status);
+  busGive();
+  return status;
+}
+
+// Hand the devices to the transport `TFL_MULTI_DEVICES` at a time,
+// each group under the bus lock, so that a transport that can queue
+// transactions does each group at once.
+uint8_t TFLI2C::readRegs( const uint8_t addr[], uint8_t n, uint8_t nmbr,
+                          uint8_t buf[], uint8_t len, uint8_t status[])
+{
+  uint8_t fail = TFL_READY;
+  if( !_Bus) fail = TFL_INVALID;
+  else if( len == 0 || len > _Bus->maxLength()) fail = TFL_I2CLENGTH;
+  if( fail != TFL_READY)
   {
-    tfStatus = TFL_I2CWRITE;        // then set status code...
-    return false;                   // and return `false`.
+    memset( status, fail, n);
+    return 0;
   }
-  // Request 1 byte from the device
-  // and release bus when finished.
-  (*_Wire).requestFrom( ( int)addr, 1, true);
-    if( (*_Wire).peek() == -1)            // If read error...
+
+  uint8_t good = 0;
+  for( uint8_t first = 0; first < n; first += TFL_MULTI_DEVICES)
+  {
+    uint8_t k = n - first;
+    if( k > TFL_MULTI_DEVICES) k = TFL_MULTI_DEVICES;
+    busTake();
+    TFL_COUNT( 2 * k, k * ( 1 + len));
+    _Bus->readMulti( addr + first, k, nmbr, buf + first * len, len, status + first);
+    for( uint8_t i = first; i < first + k; ++i)
     {
-      tfStatus = TFL_I2CREAD;         // then set status code.
-      return false;
+      if( status[ i] == TFL_READY) ++good;
+      else busFailed( addr[ i], status[ i]);
     }
-  regReply = ( uint8_t)(*_Wire).read();   // Read the received data...
-  return true;
+    busGive();
+  }
+  return good;
 }
 
-bool TFLI2C::writeReg( uint8_t nmbr, uint8_t addr, uint8_t data)
+// Only a timeout counts as a failure: a scan expects most
+// addresses not to answer.
+bool TFLI2C::probe( uint8_t addr)
 {
-  (*_Wire).beginTransmission( addr);
-  (*_Wire).write( nmbr);
-  (*_Wire).write( data);
-  if( (*_Wire).endTransmission( true) != 0)  // If write error...
+  if( !_Bus)
   {
-    tfStatus = TFL_I2CWRITE;        // then set status code...
-    return false;                   // and return `false`.
+    tfStatus = TFL_INVALID;
+    return false;
   }
-  else return true;
+  busTake();
+  TFL_COUNT( 1, 1);
+  uint8_t status = _Bus->probe( addr);
+  if( status == TFL_TIMEOUT) busFailed( addr, status);
+  busGive();
+  tfStatus = status;
+  return( status == TFL_READY);
+}
+
+// Write `len` bytes from `buf` to contiguous registers,
+// starting from register `nmbr`, in one transaction.
+bool TFLI2C::writeRegs( uint8_t nmbr, const uint8_t buf[], uint8_t len, uint8_t addr)
+{
+  uint8_t status = writeBus( nmbr, buf, len, addr);
+  if( status == TFL_READY) return true;
+  tfStatus = status;
+  return false;
+}
+
+uint8_t TFLI2C::writeBus( uint8_t nmbr, const uint8_t buf[], uint8_t len, uint8_t addr)
+{
+  if( !_Bus) return TFL_INVALID;
+  // The register number takes one byte of the bus buffer.
+  if( len == 0 || len > ( _Bus->maxLength() - 1)) return TFL_I2CLENGTH;
+
+  busTake();
+  TFL_COUNT( 1, 1 + len);
+  uint8_t status = _Bus->writeRegs( addr, nmbr, buf, len);
+  if( status != TFL_READY) busFailed( addr, status);
+  busGive();
+  return status;
+}
+
+// Count a failed transaction and, after a timeout, have the
+// transport recover the bus.  Called with the bus lock held.
+void TFLI2C::busFailed( uint8_t addr, uint8_t status)
+{
+  TFL_COUNT_ERR( addr, status);
+  (void)addr;
+  if( status != TFL_TIMEOUT || !_Bus->recover()) return;
+#ifdef TFL_STATS
+  ++stats.recoveries;
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                 BUS TIMEOUT AND RECOVERY
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Limit every transaction to about `us` microseconds, so that a
+// stuck slave cannot freeze the sketch.  Returns false if the
+// transport has no transaction timeout.
+bool TFLI2C::Set_Timeout( uint32_t us)
+{
+    bool ok = false;
+    if( _Bus)
+    {
+      busTake();
+      ok = _Bus->setTimeout( us);
+      busGive();
+    }
+    if( !ok) tfStatus = TFL_INVALID;
+    return ok;
+}
+
+// Any pair of functions may be given, for example to take and give
+// a FreeRTOS mutex.  Pass the same functions and `ctx` to every
+// `TFLI2C` object on the bus, and to nothing else that uses it.
+void TFLI2C::Set_Bus_Lock( TFLLockFn lock, TFLLockFn unlock, void *ctx)
+{
+    busLock = lock;
+    busUnlock = unlock;
+    lockCtx = ctx;
+}
+
+#if defined( ARDUINO)
+// Pins of the default Wire transport.  With the pins of a
+// transport given to `Set_Bus`, call its own `setPins`.
+void TFLI2C::Set_Bus_Pins( uint8_t sda, uint8_t scl)
+{
+    wire.setPins( sda, scl);
+}
+#endif
+
+// Returns false if the transport cannot recover the bus,
+// or if the bus is still held.
+bool TFLI2C::Bus_Recover()
+{
+    if( !_Bus) return false;
+    busTake();
+    bool ok = _Bus->recover();
+    busGive();
+#ifdef TFL_STATS
+    if( ok) ++stats.recoveries;
+#endif
+    return ok;
+}
+
+// Burst read `len` bytes of the data frame, starting
+// from register `TFL_DIST_LO`, into `dataArray`.
+bool TFLI2C::readFrame( uint8_t len, uint8_t addr)
+{
+  TFL_TIME_START();
+  frameLen = 0;
+  if( !readRegs( TFL_DIST_LO, dataArray, len, addr)) return false;
+  frameLen = len;
+  TFL_TIME_FRAME();
+  return true;
+}
+
+#ifdef TFL_STATS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                  INSTRUMENTATION
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const TFLStats &TFLI2C::getStats()
+{
+    return stats;
+}
+
+void TFLI2C::clearStats()
+{
+    memset( &stats, 0, sizeof( stats));
+}
+
+// Count a bus error against the device, in the first free slot
+// if it has none yet.  Errors of devices beyond the first
+// `TFL_STATS_DEVICES` are not counted per device.
+void TFLI2C::countError( uint8_t addr, uint8_t status)
+{
+    for( uint8_t i = 0; i < TFL_STATS_DEVICES; ++i)
+    {
+      TFLDevStats &d = stats.dev[ i];
+      if( d.addr != addr && d.addr != 0) continue;
+      d.addr = addr;
+      if( status == TFL_I2CWRITE) ++d.writeErrors;
+      else if( status == TFL_TIMEOUT) ++d.timeouts;
+      else ++d.readErrors;
+      return;
+    }
+}
+#endif  // TFL_STATS
+
+// Status code of the last command, READY = 0
+uint8_t TFLI2C::getStatus()
+{
+    return tfStatus;
+}
+
+// Limits used to validate every data frame.  The default limits
+// reject a signal strength below `TFL_WEAK_FLUX` or saturated.
+void TFLI2C::Set_Limits( const TFLLimits &lim)
+{
+    limits = lim;
+}
+
+const TFLLimits &TFLI2C::Get_Limits()
+{
+    return limits;
+}
+
+// Two more bytes in each burst, so it is left off by default
+void TFLI2C::Set_Err_Check( bool on)
+{
+    burstLen = on ? TFL_FRAME_ERR : TFL_FRAME_TICK;
+}
+
+#if defined( ARDUINO)
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                 WIRE TRANSPORT
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TFLWireBus::TFLWireBus( TwoWire &wire)
+{
+    _Wire = &wire;
+    clock = 0;
+    timeoutUs = 0;
+    sdaPin = TFL_NO_PIN;
+    sclPin = TFL_NO_PIN;
+}
+
+void TFLWireBus::setWire( TwoWire &wire)
+{
+    _Wire = &wire;
+}
+
+void TFLWireBus::setPins( uint8_t sda, uint8_t scl)
+{
+    sdaPin = sda;
+    sclPin = scl;
+}
+
+uint8_t TFLWireBus::readRegs( uint8_t addr, uint8_t reg, uint8_t *buf, uint8_t len)
+{
+    uint8_t status = writeRegs( addr, reg, NULL, 0);
+    if( status != TFL_READY) return status;
+    return receive( addr, buf, len);
+}
+
+uint8_t TFLWireBus::writeRegs( uint8_t addr, uint8_t reg, const uint8_t *buf, uint8_t len)
+{
+    (*_Wire).beginTransmission( addr);
+    (*_Wire).write( reg);
+    if( len) (*_Wire).write( buf, len);
+    return endWrite();
+}
+
+// An address byte alone, with no register number
+uint8_t TFLWireBus::probe( uint8_t addr)
+{
+    (*_Wire).beginTransmission( addr);
+    return endWrite();
+}
+
+// End a write transaction with a STOP.  If it failed, return
+// `TFL_I2CWRITE`, or `TFL_TIMEOUT` if it timed out.
+uint8_t TFLWireBus::endWrite()
+{
+    uint8_t err = (*_Wire).endTransmission( true);
+    return( err == 0) ? TFL_READY : tflWriteStatus( err);
+}
+
+// Request `len` bytes from the device and release the bus.  If
+// fewer arrive, flush them and return `TFL_I2CREAD`, or
+// `TFL_TIMEOUT` if the Wire library reports a timeout.
+uint8_t TFLWireBus::receive( uint8_t addr, uint8_t *buf, uint8_t len)
+{
+    if( (*_Wire).requestFrom( ( int)addr, ( int)len, true) == len)
+    {
+      for( uint8_t i = 0; i < len; ++i)
+      {
+        buf[ i] = ( uint8_t)(*_Wire).read();   // Read the received data...
+      }
+      return TFL_READY;
+    }
+
+    while( (*_Wire).available()) (*_Wire).read();  // flush any partial reply
+#if defined( WIRE_HAS_TIMEOUT)
+    if( (*_Wire).getWireTimeoutFlag())
+    {
+      (*_Wire).clearWireTimeoutFlag();
+      return TFL_TIMEOUT;
+    }
+#endif
+    return TFL_I2CREAD;
+}
+
+bool TFLWireBus::setClock( uint32_t hz)
+{
+    clock = hz;
+    (*_Wire).setClock( hz);
+    return true;
+}
+
+// Cores with the AVR Wire timeout also reset the I2C hardware
+// after a timeout; ESP32 takes whole milliseconds.
+bool TFLWireBus::setTimeout( uint32_t us)
+{
+#if defined( WIRE_HAS_TIMEOUT) || defined( ARDUINO_ARCH_ESP32)
+    timeoutUs = us;
+    applyTimeout();
+    return true;
+#else
+    ( void)us;
+    return false;
+#endif
+}
+
+void TFLWireBus::applyTimeout()
+{
+#if defined( WIRE_HAS_TIMEOUT)
+    (*_Wire).setWireTimeout( timeoutUs, true);
+#elif defined( ARDUINO_ARCH_ESP32)
+    (*_Wire).setTimeOut( ( timeoutUs + 999) / 1000);
+#endif
+}
+
+// A slave that was interrupted in the middle of a byte may hold
+// SDA low and wait for clocks that never come.  Release the Wire
+// library, toggle SCL up to nine times until SDA is released, then
+// send a STOP.  Restart the Wire library with the last clock and
+// timeout that were set.  Returns true if both lines are high, or
+// false at once if the pins were not set.
+bool TFLWireBus::recover()
+{
+    if( sdaPin == TFL_NO_PIN || sclPin == TFL_NO_PIN) return false;
+
+    (*_Wire).end();
+    pinMode( sdaPin, INPUT_PULLUP);
+    pinMode( sclPin, INPUT_PULLUP);
+    delayMicroseconds( TFL_RECOVER_US);
+
+    for( uint8_t i = 0; i < 9 && digitalRead( sdaPin) == LOW; ++i)
+    {
+      digitalWrite( sclPin, LOW);         // drive SCL low...
+      pinMode( sclPin, OUTPUT);
+      delayMicroseconds( TFL_RECOVER_US);
+      pinMode( sclPin, INPUT_PULLUP);     // ...then let it float high
+      for( uint8_t w = 0; w < 100 && digitalRead( sclPin) == LOW; ++w)
+      {
+        delayMicroseconds( TFL_RECOVER_US);   // allow clock stretching
+      }
+      delayMicroseconds( TFL_RECOVER_US);
+    }
+
+    // STOP: SDA rises while SCL is high
+    digitalWrite( sdaPin, LOW);
+    pinMode( sdaPin, OUTPUT);
+    delayMicroseconds( TFL_RECOVER_US);
+    pinMode( sdaPin, INPUT_PULLUP);
+    delayMicroseconds( TFL_RECOVER_US);
+    bool ok = ( digitalRead( sdaPin) == HIGH) && ( digitalRead( sclPin) == HIGH);
+
+    (*_Wire).begin();
+    if( clock) (*_Wire).setClock( clock);
+    if( timeoutUs) applyTimeout();
+    return ok;
 }
+#endif  // ARDUINO
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // - - - - -    The following is for testing purposes    - - - -
@@ -294,7 +1285,10 @@ void TFLI2C::printStatus()
     else if( tfStatus == TFL_WEAK)      Serial.print( "Signal weak");
     else if( tfStatus == TFL_STRONG)    Serial.print( "Signal strong");
     else if( tfStatus == TFL_FLOOD)     Serial.print( "Ambient light");
+    else if( tfStatus == TFL_MEASURE)   Serial.print( "Out of range");
     else if( tfStatus == TFL_INVALID)   Serial.print( "No Command");
+    else if( tfStatus == TFL_STALE)     Serial.print( "No new frame");
+    else if( tfStatus == TFL_DEVERR)    Serial.print( "Device error");
     else Serial.print( "OTHER");
 }
 
@@ -306,7 +1300,7 @@ void TFLI2C::printDataArray()
     printStatus();
     // Print the Hex value of each byte of data
     Serial.print(" Data:");
-    for( uint8_t i = 0; i < 6; i++)
+    for( uint8_t i = 0; i < frameLen; i++)
     {
       Serial.print(" ");
       Serial.print( dataArray[ i] < 16 ? "0" : "");
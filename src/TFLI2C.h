@@ -6,13 +6,50 @@
               to TFL_DEF_ADDR and TFL_DEF_FPS in header file.
               Changed `printStatus` from private to public
               0.2.0 - Corrected (reversed) Enable/Disable commands
+              0.3.0 - `getData` reads the whole data frame in one
+              I2C burst. Added `getData` overloads that also pass
+              back the device tick and error registers.
+              Added `readRegs` and `writeRegs` block commands.
+              Explicit commands now use them.
+              Added asynchronous `startRead`, `poll` and `isReady`.
+              Added `getStatus` and an include guard.
+              Added `getFreshData` and the `TFL_STALE` status.
+              Added the `TFLFrame` record and `readResult( frame)`.
+              Replaced the hard-coded signal strength check with
+              the configurable `TFLLimits` validator. Fixed the
+              saturation check that could never be true.
+              Added optional `TFL_STATS` instrumentation.
+              Added `Set_Bus_Clock` clock negotiation.
+              Added a cached shadow of the configuration registers.
+              Added `Get_Trig_Mode`, `Get_Enable`, `Get_Lo_Power`,
+              `Set_Lo_Power` and `Set_Normal_Power`.
+              Added `Set_Timeout`, `TFL_TIMEOUT` reporting and
+              9-clock bus recovery with `Set_Bus_Pins`/`Bus_Recover`.
+              Added `Set_Bus_Lock` and a reentrant `getData( TFLFrame&)`
+              for tasks sharing one bus under an RTOS.
+              Added `getFrame` and the `TFLStatus` enum.
+              Added `readBatch` for captures of many frames.
+              Transactions go through a `TFLBus` transport, so that
+              the library runs on other buses, a host and a mock.
+              Added `getFrames` to read several devices in one batch.
+              Named the production code registers `TFL_PROD_CODE`.
+              Added `probe` and a `readRegs` of several devices.
+              Added `Set_Err_Check` and the `TFL_DEVERR` status.
+              `poll` receives in the background where the transport can.
  * Described: Arduino Library for the Benewake TF-Luna Lidar sensor
  *            configured for the I2C interface
  *
  */
 
-#include <Arduino.h>    // Always include this. It's important.
-#include <Wire.h>
+#ifndef TFLI2C_H       // Guard against multiple inclusion
+#define TFLI2C_H
+
+#if defined( ARDUINO)
+  #include <Arduino.h>    // Always include this. It's important.
+  #include <Wire.h>
+#else
+  #include <TFLHost.h>    // the few Arduino functions used, off Arduino
+#endif
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 //      Definitions
@@ -35,6 +72,26 @@
 #define TFL_VER_REV          0x0A  //R
 #define TFL_VER_MIN          0x0B  //R
 #define TFL_VER_MAJ          0x0C  //R
+#define TFL_PROD_CODE        0x10  //R -- 14 ASCII bytes, 0x10 to 0x1D
+#define TFL_PROD_LEN         14    // length of the production code
+
+// - - - -   Data Frame Lengths   - - - -
+// Number of contiguous registers read in one burst by `getData`,
+// always starting from register `TFL_DIST_LO`.
+#define TFL_FRAME_LEN        6  // dist, flux and temp
+#define TFL_FRAME_TICK       8  //  "  plus tick (timestamp)
+#define TFL_FRAME_ERR       10  //  "  plus tick and error
+
+// - - - -   Wire Buffer Length   - - - -
+// Largest number of bytes the Wire library can move in
+// one transaction. Varies with the platform core.
+#if defined( BUFFER_LENGTH)
+  #define TFL_WIRE_BUFFER    BUFFER_LENGTH        // AVR, megaAVR
+#elif defined( I2C_BUFFER_LENGTH)
+  #define TFL_WIRE_BUFFER    I2C_BUFFER_LENGTH    // ESP32, ESP8266
+#else
+  #define TFL_WIRE_BUFFER    32                   // lowest common value
+#endif
 
 #define TFL_SAVE_SETTINGS    0x20  //W -- Write 0x01 to save
 #define TFL_SOFT_RESET       0x21  //W -- Write 0x02 to reboot.
@@ -85,7 +142,314 @@
 #define TFL_FLOOD           12  // Ambient Light saturation
 #define TFL_MEASURE         13
 #define TFL_INVALID         14  // Invalid operation sent to sendCommand()
+#define TFL_STALE           15  // No new frame since the last read
+#define TFL_DEVERR          16  // Device error register is not zero
+
+// The same status codes as a strongly typed enum, as kept in
+// `TFLFrame`.  Convert a code from `getStatus` with `tflStatus`.
+enum class TFLStatus : uint8_t
+{
+    Ready         = TFL_READY,
+    SerialTimeout = TFL_SERIAL,
+    Header        = TFL_HEADER,
+    Checksum      = TFL_CHECKSUM,
+    Timeout       = TFL_TIMEOUT,
+    Pass          = TFL_PASS,
+    Fail          = TFL_FAIL,
+    I2CRead       = TFL_I2CREAD,
+    I2CWrite      = TFL_I2CWRITE,
+    I2CLength     = TFL_I2CLENGTH,
+    Weak          = TFL_WEAK,
+    Strong        = TFL_STRONG,
+    Flood         = TFL_FLOOD,
+    Measure       = TFL_MEASURE,
+    Invalid       = TFL_INVALID,
+    Stale         = TFL_STALE,
+    DevError      = TFL_DEVERR
+};
+
+inline TFLStatus tflStatus( uint8_t code) { return static_cast< TFLStatus>( code);}
+
+// True if a frame with this status was read and decoded, even if its
+// data is abnormal.  Otherwise its data and tick are not to be used.
+inline bool tflDecoded( uint8_t code)
+{
+    return( code == TFL_READY || code == TFL_WEAK || code == TFL_STRONG ||
+            code == TFL_FLOOD || code == TFL_MEASURE || code == TFL_DEVERR);
+}
+
+// Asynchronous read state definitions
+#define TFL_ASYNC_IDLE       0  // no read in progress
+#define TFL_ASYNC_ADDR       1  // register pointer sent, frame pending
+#define TFL_ASYNC_READY      2  // frame received, result may be read
+#define TFL_ASYNC_RECV       3  // frame being received in the background
+
+// Asynchronous read completion callback.
+// Called by `poll()` with the device address and status code.
+typedef void ( *TFLCallback)( uint8_t addr, uint8_t status);
+
+// Bus lock and unlock functions, for example to take and give a
+// FreeRTOS mutex.  Called with the `ctx` given to `Set_Bus_Lock`.
+typedef void ( *TFLLockFn)( void *ctx);
+
+// One data frame and its status, as kept by `TFLRing`
+struct TFLFrame
+{
+    int16_t  dist;       // distance in centimeters
+    int16_t  flux;       // signal strength
+    int16_t  temp;       // temperature in 0.01 degree Celsius
+    uint16_t tick;       // device tick (timestamp) in milliseconds
+    uint8_t  addr;       // I2C address of the device
+    TFLStatus status;    // status of the read and the data
+
+    bool ok() const { return status == TFLStatus::Ready;}
+};
+
+// Ten bytes with no padding, so a frame is cheap to copy and return
+static_assert( sizeof( TFLFrame) == 10, "TFLFrame must not be padded");
+
+// - - - -   Multi-Device Read   - - - -
+#define TFL_MULTI_DEVICES    8   // devices passed to `readMulti` at once
+
+// - - - -   Batch Read   - - - -
+#define TFL_BATCH_KEEP_BAD   0x01  // keep frames that fail the limits
+#define TFL_BATCH_NO_PACE    0x02  // poll without waiting for the frame period
+#define TFL_BATCH_WAIT_MS    2000  // default longest wait for a new frame
+#define TFL_BATCH_RETRY_US   1000  // wait after a bus error
+
+struct TFLBatchOpts
+{
+    uint8_t  flags;          // `TFL_BATCH_*` flags
+    uint16_t waitMs;         // give up after this long without a new frame
+
+    TFLBatchOpts( uint8_t f = 0, uint16_t w = TFL_BATCH_WAIT_MS)
+        : flags( f), waitMs( w) {}
+};
+
+struct TFLBatchStats
+{
+    size_t   frames;         // frames stored
+    uint16_t stale;          // reads that found no new frame
+    uint16_t rejects;        // new frames that failed the limits, not kept
+    uint16_t busErrors;      // reads that failed, on the bus or otherwise
+    uint32_t elapsedUs;      // time taken by the batch
+};
+
+// - - - -   Bus Timeout and Recovery   - - - -
+#define TFL_WIRE_TIMEOUT     5   // `endTransmission` code for a timeout
+#define TFL_RECOVER_US       5   // half clock period of bus recovery
+#define TFL_NO_PIN         255   // recovery pins not set
+
+// Status code of a failed `endTransmission`
+inline uint8_t tflWriteStatus( uint8_t err)
+{
+    return( err == TFL_WIRE_TIMEOUT) ? TFL_TIMEOUT : TFL_I2CWRITE;
+}
+
+// - - - -   Checksum   - - - -
+// CRC-8 of `n` bytes, polynomial 0x07, continuing from `crc`
+inline uint8_t tflCrc8( const uint8_t *p, size_t n, uint8_t crc = 0)
+{
+    while( n--)
+    {
+      crc ^= *p++;
+      for( uint8_t b = 0; b < 8; ++b) crc = ( crc & 0x80) ? ( crc << 1) ^ 0x07 : crc << 1;
+    }
+    return crc;
+}
+
+// - - - -   Configuration Shadow   - - - -
+// The writable registers `TFL_SAVE_SETTINGS` to `TFL_HARD_RESET`
+// are kept in a per-device shadow.  Only the registers that hold
+// a setting are cached. Command registers are always written.
+#define TFL_SHADOW_SLOTS     8   // devices with a cached configuration
+#define TFL_SHADOW_FIRST  TFL_SAVE_SETTINGS
+#define TFL_SHADOW_LEN      10   // registers 0x20 to 0x29
+#define TFL_SHADOW_MASK  0x01EC  // bits of I2C_ADDR, TRIG_MODE, DISABLE,
+                                 // FPS_LO, FPS_HI and SET_LO_PWR
+
+// Cached configuration registers of one device
+struct TFLShadow
+{
+    uint8_t  addr;                   // I2C address, 0 = slot unused
+    uint16_t valid;                  // bit n set if `reg[ n]` is known
+    uint8_t  reg[ TFL_SHADOW_LEN];   // registers 0x20 to 0x29
+};
+
+// - - - -   I2C Clock Negotiation   - - - -
+#define TFL_CLOCK_STEPS      3   // 100kHz, 400kHz and 1MHz
+#define TFL_CLOCK_PROBES    50   // identification reads at each clock
+
+// Results of the last `Set_Bus_Clock` negotiation
+struct TFLClockProbe
+{
+    uint32_t clock[ TFL_CLOCK_STEPS];    // clock tried in Hz, 0 = not tried
+    uint16_t errors[ TFL_CLOCK_STEPS];   // failed or mismatched reads
+    uint16_t probes;                     // reads made at each clock
+    uint32_t chosen;                     // clock settled on in Hz, 0 = none
+};
+
+// - - - -   Instrumentation   - - - -
+// Uncomment, or define in the build flags, to count transactions,
+// bytes, bus errors and data frame read times in a `TFLStats`
+// record.  When not defined the counters are compiled out entirely.
+//#define TFL_STATS
+#define TFL_STATS_DEVICES    8   // devices with their own error counts
+
+#ifdef TFL_STATS
+// Bus error counts of one device
+struct TFLDevStats
+{
+    uint8_t  addr;           // I2C address, 0 = slot unused
+    uint16_t writeErrors;    // `TFL_I2CWRITE` failures
+    uint16_t readErrors;     // `TFL_I2CREAD` failures
+    uint16_t timeouts;       // `TFL_TIMEOUT` failures
+};
+
+struct TFLStats
+{
+    uint32_t transactions;   // I2C transactions issued
+    uint32_t bytes;          // bytes moved, register numbers included
+    uint32_t frames;         // data frames read by `getData`
+    uint32_t frameMin;       // shortest data frame read, microseconds
+    uint32_t frameMax;       // longest data frame read, microseconds
+    uint32_t frameSum;       // total data frame read time, microseconds
+    uint32_t recoveries;     // bus recoveries made
+    TFLDevStats dev[ TFL_STATS_DEVICES];
+
+    // Mean data frame read time in microseconds
+    uint32_t frameMean() const { return frames ? ( frameSum / frames) : 0;}
+};
+#endif  // TFL_STATS
 
+// - - - -   Data Frame Validation Defaults   - - - -
+#define TFL_WEAK_FLUX       100     // flux below this is weak
+#define TFL_STRONG_FLUX  0xFFFF     // flux at or above this is saturated
+#define TFL_FLOOD_DIST       -4     // distance code for ambient light
+                                    // saturation on other Benewake
+                                    // devices, not in the TF-Luna
+                                    // register map
+
+// Validate a data frame from the bytes already read.
+// Set `weakFlux` to 0 to disable that check.  The ambient light
+// check is off, `floodDist` 0, unless `floodDist` is set, for
+// example to `TFL_FLOOD_DIST`.
+// Distances outside `minDist` to `maxDist` fail with `TFL_MEASURE`.
+struct TFLLimits
+{
+    uint16_t weakFlux;     // flux less than this is `TFL_WEAK`
+    uint16_t strongFlux;   // flux at least this is `TFL_STRONG`
+    int16_t  floodDist;    // distance equal to this is `TFL_FLOOD`
+    int16_t  minDist;      // shortest distance accepted, in cm
+    int16_t  maxDist;      // longest distance accepted, in cm
+
+    TFLLimits() : weakFlux( TFL_WEAK_FLUX), strongFlux( TFL_STRONG_FLUX),
+        floodDist( 0), minDist( -32768), maxDist( 32767) {}
+
+    // Returns READY or the status code of the abnormal value.
+    // The flux is compared as an unsigned value, so that the
+    // saturation value 0xFFFF is not mistaken for -1.
+    uint8_t evaluate( int16_t dist, int16_t flux) const
+    {
+        uint16_t amp = ( uint16_t)flux;
+        if( floodDist != 0 && dist == floodDist) return TFL_FLOOD;
+        if( amp >= strongFlux) return TFL_STRONG;
+        if( amp < weakFlux) return TFL_WEAK;
+        if( dist < minDist || dist > maxDist) return TFL_MEASURE;
+        return TFL_READY;
+    }
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                 BUS TRANSPORT
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Every transaction of `TFLI2C` goes through a `TFLBus`.  A transport
+// moves bytes to and from the registers of a device and returns
+// `TFL_READY` or the status of a failure: `TFL_I2CWRITE`, `TFL_I2CREAD`
+// or `TFL_TIMEOUT`.  `TFLWireBus` is the Arduino Wire transport and is
+// used by default.  Other transports, or a mock for tests, may be given
+// to `Set_Bus`.
+class TFLBus
+{
+  public:
+    virtual ~TFLBus() {}
+
+    // Write register number `reg`, then read `len` bytes into `buf`
+    virtual uint8_t readRegs( uint8_t addr, uint8_t reg, uint8_t *buf, uint8_t len) = 0;
+    // Write register number `reg` and then `len` bytes of `buf`.
+    // With `len` 0 only the register pointer is written.
+    virtual uint8_t writeRegs( uint8_t addr, uint8_t reg, const uint8_t *buf, uint8_t len) = 0;
+    // Read `len` bytes from the register pointer written before
+    virtual uint8_t receive( uint8_t addr, uint8_t *buf, uint8_t len) = 0;
+
+    // Largest read.  A write takes the register number and one less.
+    virtual uint8_t maxLength() const { return 32;}
+    // Optional controls.  Return false where not supported.
+    virtual bool setClock( uint32_t hz) { ( void)hz; return false;}
+    virtual bool setTimeout( uint32_t us) { ( void)us; return false;}
+    // Free a bus held by a device.  True if the bus was recovered.
+    virtual bool recover() { return false;}
+    // Address a device and return `TFL_READY` if it acknowledges.
+    // By default the register pointer is written.
+    virtual uint8_t probe( uint8_t addr) { return writeRegs( addr, TFL_DIST_LO, NULL, 0);}
+
+    // Optional non-blocking `receive`, used by `poll`.  `startReceive`
+    // queues the read of `len` bytes into `buf`, which must stay valid,
+    // and returns `TFL_READY` at once.  `receiveDone` then returns true
+    // once the read is over, with its status.  A transport that cannot
+    // returns `TFL_INVALID`, and `poll` uses the blocking `receive`.
+    virtual uint8_t startReceive( uint8_t addr, uint8_t *buf, uint8_t len)
+    {
+        ( void)addr; ( void)buf; ( void)len;
+        return TFL_INVALID;
+    }
+    virtual bool receiveDone( uint8_t &status) { status = TFL_INVALID; return true;}
+
+    // `readRegs` of the same registers of `n` devices into `buf`,
+    // `len` bytes each, with the status of each in `status`.  A
+    // transport that can queue transactions should do them at once.
+    virtual void readMulti( const uint8_t addr[], uint8_t n, uint8_t reg,
+                            uint8_t *buf, uint8_t len, uint8_t status[])
+    {
+        for( uint8_t i = 0; i < n; ++i)
+        {
+          status[ i] = readRegs( addr[ i], reg, buf + i * len, len);
+        }
+    }
+};
+
+#if defined( ARDUINO)
+// Arduino Wire transport.  Each read is a write ended with a STOP
+// followed by a read, as the TF-Luna expects.
+class TFLWireBus : public TFLBus
+{
+  public:
+    TFLWireBus( TwoWire &wire = Wire);
+
+    void setWire( TwoWire &wire);
+    // Bus pins, so that `recover` can clock out a stuck device
+    void setPins( uint8_t sda, uint8_t scl);
+
+    uint8_t readRegs( uint8_t addr, uint8_t reg, uint8_t *buf, uint8_t len);
+    uint8_t writeRegs( uint8_t addr, uint8_t reg, const uint8_t *buf, uint8_t len);
+    uint8_t receive( uint8_t addr, uint8_t *buf, uint8_t len);
+    uint8_t maxLength() const { return TFL_WIRE_BUFFER;}
+    bool setClock( uint32_t hz);
+    bool setTimeout( uint32_t us);
+    bool recover();
+    uint8_t probe( uint8_t addr);
+
+  private:
+    TwoWire *_Wire;
+    uint32_t clock;          // last clock set, 0 = not set
+    uint32_t timeoutUs;      // transaction timeout, 0 = not set
+    uint8_t sdaPin;          // bus pins for recovery, or `TFL_NO_PIN`
+    uint8_t sclPin;
+
+    uint8_t endWrite();
+    void applyTimeout();
+};
+#endif  // ARDUINO
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 //                 OBJECT CLASS DEFINITIONS
@@ -101,20 +465,88 @@ class TFLI2C
     bool getData( int16_t &dist, int16_t &flux, int16_t &temp, uint8_t addr);
     // Get data short version
     bool getData( int16_t &dist, uint8_t addr);
+    // Get data plus device tick, or tick and error, in the same burst
+    bool getData( int16_t &dist, int16_t &flux, int16_t &temp,
+                  uint16_t &tick, uint8_t addr);
+    bool getData( int16_t &dist, int16_t &flux, int16_t &temp,
+                  uint16_t &tick, uint16_t &err, uint8_t addr);
+    // Get data only if the device tick has moved on from `tick`
+    bool getFreshData( int16_t &dist, int16_t &flux, int16_t &temp,
+                       uint16_t &tick, uint8_t addr);
+    // Get data and tick into `frame`.  Reentrant: the status is kept
+    // in `frame.status` and no member of the object is changed.
+    bool getData( TFLFrame &frame, uint8_t addr);
+    // The same, passing the frame back by value
+    TFLFrame getFrame( uint8_t addr);
+    // Read the frames of `n` devices into `out`, in as few bus calls
+    // as the transport allows.  Returns the number of good frames.
+    uint8_t getFrames( const uint8_t addr[], uint8_t n, TFLFrame out[]);
+    // Read `n` new frames into `out`, or into `dist` and `flux` arrays.
+    // Returns the number of frames stored.  `flux` may be NULL.
+    size_t readBatch( uint8_t addr, TFLFrame *out, size_t n,
+                      const TFLBatchOpts &opts = TFLBatchOpts(),
+                      TFLBatchStats *stats = NULL);
+    size_t readBatch( uint8_t addr, int16_t *dist, int16_t *flux, size_t n,
+                      const TFLBatchOpts &opts = TFLBatchOpts(),
+                      TFLBatchStats *stats = NULL);
+
+    // Asynchronous data read, one bus phase per call.  With a
+    // transport that can receive in the background, `poll` starts
+    // the frame read and returns, and a later `poll` finishes it.
+    bool startRead( uint8_t addr, TFLCallback cb = NULL,
+                    uint8_t len = TFL_FRAME_LEN);
+    bool poll();
+    bool isReady();
+    bool readResult( int16_t &dist, int16_t &flux, int16_t &temp);
+    bool readResult( int16_t &dist, int16_t &flux, int16_t &temp,
+                     uint16_t &tick);
+    bool readResult( TFLFrame &frame);
 
     // Read From or Write To an I2C register
     bool readReg( uint8_t nmbr, uint8_t addr);
     bool writeReg( uint8_t nmbr, uint8_t addr, uint8_t data);
+    // Read From or Write To `len` contiguous registers in one transaction
+    bool readRegs( uint8_t nmbr, uint8_t buf[], uint8_t len, uint8_t addr);
+    bool writeRegs( uint8_t nmbr, const uint8_t buf[], uint8_t len, uint8_t addr);
+    // Read the same `len` registers of `n` devices into `buf`, `len`
+    // bytes each, with the status of each in `status`.  Returns the
+    // number of devices read.
+    uint8_t readRegs( const uint8_t addr[], uint8_t n, uint8_t nmbr,
+                      uint8_t buf[], uint8_t len, uint8_t status[]);
+    // True if a device acknowledges at `addr`
+    bool probe( uint8_t addr);
 
     // Explicit Device Commands
     bool Get_Firmware_Version( uint8_t ver[], uint8_t adr);
     bool Get_Frame_Rate( uint16_t &frm, uint8_t adr);
     bool Get_Prod_Code( uint8_t cod[], uint8_t adr);
     bool Get_Time( uint16_t &tim, uint8_t adr);
+    bool Get_Trig_Mode( uint8_t &trig, uint8_t adr);   // 1 = trigger
+    bool Get_Enable( uint8_t &enable, uint8_t adr);    // 1 = enabled
+    bool Get_Lo_Power( uint8_t &lopwr, uint8_t adr);   // 1 = low power
 
     bool Set_Frame_Rate( uint16_t &frm, uint8_t adr);
     bool Set_I2C_Addr( uint8_t adrNew, uint8_t adr);
+#if defined( ARDUINO)
     void Set_Bus( TwoWire *bus);
+#endif
+    // Use another transport, such as a Linux bus or a mock
+    void Set_Bus( TFLBus *bus);
+    TFLBus *Get_Bus();
+    // Hold `lock` around every whole transaction on the bus
+    void Set_Bus_Lock( TFLLockFn lock, TFLLockFn unlock, void *ctx = NULL);
+    // Step the bus clock up from 100kHz to the fastest reliable clock
+    uint32_t Set_Bus_Clock( uint8_t adr, uint32_t maxClock = 1000000UL,
+                            uint16_t probes = TFL_CLOCK_PROBES);
+    const TFLClockProbe &Get_Clock_Probe();
+    // Bound the time of every transaction, if the platform allows
+    bool Set_Timeout( uint32_t us);
+#if defined( ARDUINO)
+    // Set the Wire bus pins to enable automatic recovery after a timeout
+    void Set_Bus_Pins( uint8_t sda, uint8_t scl);
+#endif
+    // Free a bus held by a stuck slave. True if the bus was recovered.
+    bool Bus_Recover();
     bool Set_Enable( uint8_t adr);
     bool Set_Disable( uint8_t adr);
     bool Soft_Reset( uint8_t adr);  // Reset and reboot
@@ -123,6 +555,28 @@ class TFLI2C
     bool Set_Trig_Mode( uint8_t adr);
     bool Set_Cont_Mode( uint8_t adr);
     bool Set_Trigger( uint8_t adr);  // false = continuous
+    bool Set_Lo_Power( uint8_t adr);
+    bool Set_Normal_Power( uint8_t adr);
+
+    // Forget the cached configuration of a device, or of all
+    // devices if `adr` is 0, so that it is read again.
+    void Clear_Cache( uint8_t adr = 0);
+
+    // Status code of the last command: READY = 0
+    uint8_t getStatus();
+
+    // Set or get the limits used to validate every data frame
+    void Set_Limits( const TFLLimits &lim);
+    const TFLLimits &Get_Limits();
+    // Read the tick and error registers in the same burst as every
+    // data frame.  A frame whose error register is not zero is `TFL_DEVERR`.
+    void Set_Err_Check( bool on);
+
+#ifdef TFL_STATS
+    // Transaction, error and timing counts since the last clear
+    const TFLStats &getStats();
+    void clearStats();
+#endif
 
     //  For testing purposes: print reply data and status
     void printDataArray();
@@ -131,9 +585,59 @@ class TFLI2C
   private:
 
     uint8_t tfStatus;        // system error status: READY = 0
-    uint8_t dataArray[ 6];
+    uint8_t dataArray[ TFL_FRAME_ERR];
+    uint8_t frameLen;        // number of bytes in last data frame
+    uint8_t burstLen;        // `TFL_FRAME_TICK`, or `TFL_FRAME_ERR` to check errors
     uint8_t regReply;
+    TFLLimits limits;        // data frame validation limits
+    TFLClockProbe clockProbe;
+    TFLShadow shadow[ TFL_SHADOW_SLOTS];
+    uint8_t shadowNext;      // slot to reuse when all are taken
+#ifdef TFL_STATS
+    TFLStats stats;
+    void countError( uint8_t addr, uint8_t status);
+#endif
+
+    uint8_t asyncState;      // asynchronous read state: IDLE = 0
+    uint8_t asyncAddr;       // device address of the pending read
+    uint8_t asyncLen;        // frame length of the pending read
+    uint8_t asyncFail;       // status of a failed read, READY if none
+    TFLCallback asyncCb;     // completion callback or NULL
+    bool endRead();          // settle the frame read of `poll`
+
+    TFLLockFn busLock;       // bus lock functions or NULL
+    TFLLockFn busUnlock;
+    void *lockCtx;
+    void busTake() { if( busLock) busLock( lockCtx);}
+    void busGive() { if( busUnlock) busUnlock( lockCtx);}
+
+    // Whole locked transactions.  They return a status code and
+    // change no member, so that they can be called from any task.
+    uint8_t readBus( uint8_t nmbr, uint8_t buf[], uint8_t len, uint8_t addr);
+    uint8_t writeBus( uint8_t nmbr, const uint8_t buf[], uint8_t len, uint8_t addr);
+    // Count a failed transaction and recover the bus after a timeout
+    void busFailed( uint8_t addr, uint8_t status);
+    bool busClock( uint32_t hz);
+
+    size_t batch( uint8_t addr, TFLFrame *out, int16_t *dist, int16_t *flux,
+                  size_t n, const TFLBatchOpts &opts, TFLBatchStats *stats);
+
+    // Burst read `len` bytes of the data frame into `dataArray`
+    bool readFrame( uint8_t len, uint8_t addr);
+    // Shift `dataArray` into the three variables and evaluate them
+    bool decodeFrame( int16_t &dist, int16_t &flux, int16_t &temp);
+    // The same, from a data and tick burst into a `TFLFrame`
+    bool decodeFrame( const uint8_t buf[], TFLFrame &frame) const;
+
+    // Read or write configuration registers through the shadow
+    TFLShadow *shadowFor( uint8_t addr, bool make);
+    bool readCfg( uint8_t nmbr, uint8_t buf[], uint8_t len, uint8_t addr);
+    bool writeCfg( uint8_t nmbr, const uint8_t buf[], uint8_t len, uint8_t addr);
 
-    TwoWire* _Wire;
+    TFLBus *_Bus;            // transport of every transaction
+#if defined( ARDUINO)
+    TFLWireBus wire;         // the default transport
+#endif
 };
 
+#endif  // TFLI2C_H
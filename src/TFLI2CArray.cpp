@@ -0,0 +1,355 @@
+/* File Name: TFLI2CArray.cpp
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Schedules data reads across several Benewake TF-Luna
+ *            Lidar sensors sharing one I2C bus at different addresses.
+ *
+ *  Typical use:
+ *    TFLI2C tflI2C;
+ *    TFLI2CArray tflArray( tflI2C);
+ *    ...
+ *    tflArray.addDevice( 0x10);   // once for each device
+ *    tflArray.addDevice( 0x11);
+ *    tflArray.begin();
+ *    ...
+ *    int8_t i = tflArray.update();  // call as often as possible
+ *    if( i >= 0 && tflArray.getData( i, dist, flux, temp)) ...
+ *
+ *  Or, for synchronized snapshots:
+ *    tflArray.setTrigMode( true);
+ *    ...
+ *    tflArray.capture();            // trigger, wait and read all
+ *    for( i = 0; i < tflArray.count(); ++i)
+ *      if( tflArray.getData( i, dist, flux, temp)) ...
+ */
+
+#include <TFLI2CArray.h>
+
+// True if the status code means the device did not answer
+static bool isBusError( uint8_t status)
+{
+    return( status == TFL_I2CWRITE || status == TFL_I2CREAD ||
+            status == TFL_TIMEOUT);
+}
+
+// Constructor/Destructor
+TFLI2CArray::TFLI2CArray( TFLI2C &_tfl) : tfl( _tfl)
+{
+    devCount = 0;
+    freshOnly = false;
+    trigMode = false;
+    trigSkew = 0;
+}
+TFLI2CArray::~TFLI2CArray(){}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              DEVICE TABLE
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TFLI2CArray::addDevice( uint8_t addr)
+{
+    if( devCount >= TFL_MAX_DEVICES) return false;
+
+    TFLDevice &d = dev[ devCount];
+    memset( &d, 0, sizeof( d));
+    d.addr = addr;
+    d.status = TFL_READY;
+    d.online = true;
+    d.due = micros();
+    ++devCount;
+    return true;
+}
+
+// Probe every device by reading its frame rate.  Devices
+// that answer are scheduled at that rate, those that don't
+// are marked offline and probed again later by `update`.
+// The cached settings are dropped first, so that the frame
+// rate is read from the bus and an absent device is found.
+uint8_t TFLI2CArray::begin()
+{
+    uint32_t now = micros();
+    for( uint8_t i = 0; i < devCount; ++i)
+    {
+      TFLDevice &d = dev[ i];
+      uint16_t fps = 0;
+      tfl.Clear_Cache( d.addr);
+      if( tfl.Get_Frame_Rate( fps, d.addr))
+      {
+        setFrameRate( i, fps);
+        d.online = true;
+        d.fails = 0;
+        d.due = now;
+      }
+      else
+      {
+        d.status = tfl.getStatus();
+        d.online = false;
+        d.due = now + TFL_RETRY_MS * 1000UL;
+      }
+    }
+    return online();
+}
+
+void TFLI2CArray::setOnline( uint8_t idx, bool online)
+{
+    if( idx >= devCount) return;
+    dev[ idx].online = online;
+    dev[ idx].fails = 0;
+    dev[ idx].due = micros() + ( online ? 0 : TFL_RETRY_MS * 1000UL);
+}
+
+// A dropped device is skipped by `update`, `updateAll` and
+// `capture`.  Taken back, it is read at once.
+void TFLI2CArray::setDropped( uint8_t idx, bool dropped)
+{
+    if( idx >= devCount) return;
+    dev[ idx].dropped = dropped;
+    dev[ idx].fails = 0;
+    dev[ idx].due = micros();
+}
+
+// A frame rate of zero has the device read at every turn,
+// such as when it is in trigger mode.
+void TFLI2CArray::setFrameRate( uint8_t idx, uint16_t fps)
+{
+    if( idx >= devCount) return;
+    dev[ idx].fps = fps;
+    dev[ idx].period = ( fps > 0) ? ( 1000000UL / fps) : 0;
+}
+
+void TFLI2CArray::setFreshOnly( bool fresh)
+{
+    freshOnly = fresh;
+}
+
+uint8_t TFLI2CArray::count()
+{
+    return devCount;
+}
+
+uint8_t TFLI2CArray::online()
+{
+    uint8_t n = 0;
+    for( uint8_t i = 0; i < devCount; ++i)
+    {
+      if( dev[ i].online && !dev[ i].dropped) ++n;
+    }
+    return n;
+}
+
+TFLDevice &TFLI2CArray::device( uint8_t idx)
+{
+    return dev[ idx];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              SCHEDULE AND READ
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Pick the device whose next read is most overdue.  Devices
+// with a higher frame rate fall due more often and so are read
+// more often.  Offline devices fall due only at the re-probe
+// interval.  Time differences are signed so that the schedule
+// survives the roll-over of `micros()`.
+int8_t TFLI2CArray::update()
+{
+    if( trigMode) return -1;         // use `capture` instead
+
+    uint32_t now = micros();
+    int8_t pick = -1;
+    int32_t most = 0;
+    for( uint8_t i = 0; i < devCount; ++i)
+    {
+      if( dev[ i].dropped) continue;
+      int32_t lag = ( int32_t)( now - dev[ i].due);
+      if( lag < 0) continue;          // not due yet
+      if( pick < 0 || lag > most)
+      {
+        pick = i;
+        most = lag;
+      }
+    }
+    if( pick < 0) return -1;
+
+    readDevice( dev[ pick], now);
+    return pick;
+}
+
+// Read every device that is due, online or due for a re-probe,
+// with one `getFrames` call, and settle each as `update` does.
+uint8_t TFLI2CArray::updateAll()
+{
+    if( trigMode) return 0;          // use `capture` instead
+
+    uint32_t now = micros();
+    uint8_t idx[ TFL_MAX_DEVICES];
+    uint8_t addr[ TFL_MAX_DEVICES];
+    uint8_t n = 0;
+    for( uint8_t i = 0; i < devCount; ++i)
+    {
+      if( dev[ i].dropped) continue;
+      if( ( int32_t)( now - dev[ i].due) < 0) continue;   // not due yet
+      idx[ n] = i;
+      addr[ n++] = dev[ i].addr;
+    }
+    if( n == 0) return 0;
+
+    TFLFrame frame[ TFL_MAX_DEVICES];
+    tfl.getFrames( addr, n, frame);
+
+    uint8_t good = 0;
+    for( uint8_t k = 0; k < n; ++k)
+    {
+      TFLDevice &d = dev[ idx[ k]];
+      TFLFrame &f = frame[ k];
+      uint8_t status = ( uint8_t)f.status;
+      if( tflDecoded( status))
+      {
+        if( freshOnly && f.tick == d.tick) status = TFL_STALE;
+        else
+        {
+          d.dist = f.dist;
+          d.flux = f.flux;
+          d.temp = f.temp;
+          d.tick = f.tick;
+        }
+      }
+      if( settle( d, status, now)) ++good;
+    }
+    return good;
+}
+
+bool TFLI2CArray::readDevice( TFLDevice &d, uint32_t now)
+{
+    if( freshOnly) tfl.getFreshData( d.dist, d.flux, d.temp, d.tick, d.addr);
+    else tfl.getData( d.dist, d.flux, d.temp, d.addr);
+    return settle( d, tfl.getStatus(), now);
+}
+
+// Keep the status of a read and schedule the next one.
+// Returns true for a good new frame.
+bool TFLI2CArray::settle( TFLDevice &d, uint8_t status, uint32_t now)
+{
+    d.status = status;
+
+    if( isBusError( d.status))
+    {
+      busFailed( d, now);
+      return false;
+    }
+
+    d.fails = 0;
+    d.online = true;
+
+    // The device is running a little slower than the schedule.
+    // Look again after a quarter period, then rejoin the schedule.
+    if( d.status == TFL_STALE)
+    {
+      d.due = now + ( d.period >> 2);
+      return false;
+    }
+    d.fresh = true;
+
+    // Keep to the device frame rate, but if the
+    // schedule has fallen behind, restart it from now.
+    d.due += d.period;
+    if( ( int32_t)( now - d.due) >= 0) d.due = now + d.period;
+    return( d.status == TFL_READY);
+}
+
+// Count a bus failure and take the device offline after too many
+void TFLI2CArray::busFailed( TFLDevice &d, uint32_t now)
+{
+    if( d.fails < 255) ++d.fails;
+    if( d.fails >= TFL_OFFLINE_FAILS) d.online = false;
+    if( d.online)
+    {
+      d.due = now + d.period;
+      return;
+    }
+    // Offline: double the wait at each failed probe
+    uint32_t ms = TFL_RETRY_MS;
+    for( uint8_t n = d.fails - TFL_OFFLINE_FAILS; n > 0 && ms < TFL_RETRY_MAX_MS; --n) ms <<= 1;
+    if( ms > TFL_RETRY_MAX_MS) ms = TFL_RETRY_MAX_MS;
+    d.due = now + ms * 1000UL;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              SYNCHRONIZED CAPTURE
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TFLI2CArray::setTrigMode( bool trig)
+{
+    bool ok = true;
+    for( uint8_t i = 0; i < devCount; ++i)
+    {
+      TFLDevice &d = dev[ i];
+      if( !d.online || d.dropped) continue;
+      if( !( trig ? tfl.Set_Trig_Mode( d.addr) : tfl.Set_Cont_Mode( d.addr)))
+      {
+        d.status = tfl.getStatus();
+        busFailed( d, micros());
+        ok = false;
+      }
+    }
+    trigMode = trig;
+    return ok;
+}
+
+// Fire the trigger write at each online device in the tightest
+// loop possible, so that the devices sample at nearly the same
+// instant.  Then wait for the conversion, counted from the first
+// trigger, and read the devices back in the same order so that
+// each frame is about the same age when it is read.
+uint8_t TFLI2CArray::capture( uint32_t waitUs)
+{
+    bool fired[ TFL_MAX_DEVICES];
+    uint32_t first = 0, last = 0;
+    bool any = false;
+
+    for( uint8_t i = 0; i < devCount; ++i)
+    {
+      TFLDevice &d = dev[ i];
+      fired[ i] = d.online && !d.dropped && tfl.Set_Trigger( d.addr);
+      uint32_t now = micros();
+      if( fired[ i])
+      {
+        if( !any) first = now;
+        last = now;
+        any = true;
+      }
+      else if( d.online && !d.dropped)
+      {
+        d.status = tfl.getStatus();
+        busFailed( d, now);
+      }
+    }
+    trigSkew = last - first;
+    if( !any) return 0;
+
+    while( ( micros() - first) < waitUs) {}
+
+    uint8_t good = 0;
+    for( uint8_t i = 0; i < devCount; ++i)
+    {
+      if( fired[ i] && readDevice( dev[ i], micros())) ++good;
+    }
+    return good;
+}
+
+uint32_t TFLI2CArray::getTriggerSkew()
+{
+    return trigSkew;
+}
+
+// Pass back the last result of device `idx` and mark it taken.
+// Returns true only for a fresh result with a READY status.
+bool TFLI2CArray::getData( uint8_t idx, int16_t &dist, int16_t &flux, int16_t &temp)
+{
+    if( idx >= devCount) return false;
+    TFLDevice &d = dev[ idx];
+    dist = d.dist;
+    flux = d.flux;
+    temp = d.temp;
+    bool ok = d.fresh && ( d.status == TFL_READY);
+    d.fresh = false;
+    return ok;
+}
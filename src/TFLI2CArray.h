@@ -0,0 +1,128 @@
+/* File Name: TFLI2CArray.h
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Schedules data reads across several Benewake TF-Luna
+ *            Lidar sensors sharing one I2C bus at different addresses.
+ *
+ *  A `TFLI2CArray` uses one `TFLI2C` object to talk to a table of up
+ *  to `TFL_MAX_DEVICES` devices.  Each device has its own result slot
+ *  and status, so one device's read no longer clobbers another's.
+ *
+ *  `update()` reads the one device that is most overdue according to
+ *  its own frame rate, so no bus time is spent re-reading a device
+ *  faster than it makes new frames.  A device that fails to answer
+ *  `TFL_OFFLINE_FAILS` times in a row is marked offline and skipped,
+ *  and is probed again after `TFL_RETRY_MS` milliseconds.  Each probe
+ *  that fails doubles the wait, up to `TFL_RETRY_MAX_MS`, so that a dead
+ *  device does not hold the bus with timeouts.  A device dropped with
+ *  `setDropped` is not read or probed until it is taken back.
+ *
+ *  `updateAll()` reads every device that is due with one `getFrames`
+ *  call instead, which a transport such as `TFLLinuxBus` turns into
+ *  one system call for all of them.
+ *
+ *  With `setFreshOnly( true)` each read also checks the device tick
+ *  and a frame that was already read is not passed on again.
+ *
+ *  For near-simultaneous snapshots, `setTrigMode( true)` puts every
+ *  device in trigger mode and `capture()` then triggers all online
+ *  devices back-to-back, waits for the conversion and reads them all.
+ *  `getTriggerSkew()` is the time between the first and the last
+ *  trigger, which tells how close to simultaneous the snapshot was.
+ */
+
+#ifndef TFLI2CARRAY_H
+#define TFLI2CARRAY_H
+
+#include <TFLI2C.h>
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//      Definitions
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#define TFL_MAX_DEVICES      8   // devices in one `TFLI2CArray`
+#define TFL_OFFLINE_FAILS    3   // consecutive bus failures to go offline
+#define TFL_RETRY_MS      1000   // offline device re-probe interval
+#define TFL_RETRY_MAX_MS 32000   // longest re-probe interval after back-off
+#define TFL_TRIG_WAIT_US  5000   // default wait from trigger to read
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                 OBJECT CLASS DEFINITIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// One slot of the device table
+struct TFLDevice
+{
+    uint8_t  addr;       // I2C address of the device
+    uint16_t fps;        // configured frame rate, 0 = read at every turn
+    uint32_t period;     // microseconds between reads
+    uint32_t due;        // `micros()` time when the next read is due
+    int16_t  dist;       // last distance in centimeters
+    int16_t  flux;       // last signal strength
+    int16_t  temp;       // last temperature in 0.01 degree Celsius
+    uint16_t tick;       // device tick of the last frame
+    uint8_t  status;     // status code of the last read: READY = 0
+    uint8_t  fails;      // consecutive bus failures
+    bool     online;     // false if the device stopped answering
+    bool     dropped;    // taken out of the schedule, not even probed
+    bool     fresh;      // true if the result has not been taken yet
+};
+
+class TFLI2CArray
+{
+  public:
+    TFLI2CArray( TFLI2C &tfl);
+    ~TFLI2CArray();
+
+    // Add a device to the table. Returns false if the table is full.
+    bool addDevice( uint8_t addr);
+    // Probe every device and read its frame rate.
+    // Returns the number of devices that are online.
+    uint8_t begin();
+    // Read the device that is most overdue.
+    // Returns the table index of the device read, or -1 if none was due.
+    int8_t update();
+    // Read every device that is due in one batch.
+    // Returns the number of good new frames.
+    uint8_t updateAll();
+
+    // Take the last result of device `idx`.
+    // Returns false if the result is not valid.
+    bool getData( uint8_t idx, int16_t &dist, int16_t &flux, int16_t &temp);
+    // Mark a device online again, or take it out of the schedule
+    void setOnline( uint8_t idx, bool online);
+    // Drop a device from the schedule for good, or take it back
+    void setDropped( uint8_t idx, bool dropped);
+    // Set or change the frame rate the schedule expects of device `idx`
+    void setFrameRate( uint8_t idx, uint16_t fps);
+    // Pass on only frames with a new device tick
+    void setFreshOnly( bool fresh);
+
+    // Put every online device in trigger or continuous mode.
+    // Returns false if any device failed to answer.
+    bool setTrigMode( bool trig);
+    // Trigger all online devices, wait `waitUs` and read them all.
+    // Returns the number of good frames.
+    uint8_t capture( uint32_t waitUs = TFL_TRIG_WAIT_US);
+    // Microseconds between the first and last trigger of `capture`
+    uint32_t getTriggerSkew();
+
+    uint8_t count();
+    uint8_t online();
+    TFLDevice &device( uint8_t idx);
+
+  private:
+    TFLI2C &tfl;
+    TFLDevice dev[ TFL_MAX_DEVICES];
+    uint8_t devCount;
+    bool freshOnly;
+    bool trigMode;           // `update` is idle in trigger mode
+    uint32_t trigSkew;
+
+    bool readDevice( TFLDevice &d, uint32_t now);
+    bool settle( TFLDevice &d, uint8_t status, uint32_t now);
+    void busFailed( TFLDevice &d, uint32_t now);
+};
+
+#endif  // TFLI2CARRAY_H
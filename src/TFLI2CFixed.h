@@ -0,0 +1,186 @@
+/* File Name: TFLI2CFixed.h
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Compile-time configured version of the TFLI2C library
+ *            for a Benewake TF-Luna at a fixed address on a fixed bus.
+ *
+ *  The bus and the I2C address are template parameters rather than
+ *  a member pointer and a function argument.  The compiler can then
+ *  inline the whole transaction sequence and call the bus object
+ *  directly.  An address outside the range 0x08 to 0x77 accepted by
+ *  `Set_I2C_Addr` is refused at compile time.
+ *
+ *  Example:
+ *    TFLI2CFixed< Wire, TFL_DEF_ADR> tflI2C;
+ *    ...
+ *    if( tflI2C.getData( dist, flux, temp)) ...
+ *
+ *  The commands behave exactly as those of `TFLI2C` of the same name,
+ *  but without the address argument.
+ */
+
+#ifndef TFLI2CFIXED_H
+#define TFLI2CFIXED_H
+
+#include <TFLI2C.h>
+
+#if !defined( ARDUINO)
+  #error "TFLI2CFixed calls the Arduino Wire library directly"
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                 OBJECT CLASS DEFINITIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template< TwoWire &Bus, uint8_t Addr>
+class TFLI2CFixed
+{
+    static_assert( Addr >= 0x08 && Addr <= 0x77,
+                   "TF-Luna I2C address must be in the range 0x08 to 0x77");
+
+  public:
+    TFLI2CFixed() : tfStatus( TFL_READY) {}
+
+    // - - - -   Get data   - - - -
+    bool getData( int16_t &dist, int16_t &flux, int16_t &temp)
+    {
+        uint8_t buf[ TFL_FRAME_LEN];
+        if( !readRegs( TFL_DIST_LO, buf, TFL_FRAME_LEN)) return false;
+        return decode( buf, dist, flux, temp);
+    }
+
+    bool getData( int16_t &dist)
+    {
+        int16_t flux, temp;
+        return getData( dist, flux, temp);
+    }
+
+    bool getFreshData( int16_t &dist, int16_t &flux, int16_t &temp,
+                       uint16_t &tick)
+    {
+        uint8_t buf[ TFL_FRAME_TICK];
+        if( !readRegs( TFL_DIST_LO, buf, TFL_FRAME_TICK)) return false;
+        uint16_t newTick = buf[ 6] + ( buf[ 7] << 8);
+        if( newTick == tick)
+        {
+          tfStatus = TFL_STALE;
+          return false;
+        }
+        tick = newTick;
+        return decode( buf, dist, flux, temp);
+    }
+
+    // - - - -   Read From or Write To I2C registers   - - - -
+    bool readRegs( uint8_t nmbr, uint8_t buf[], uint8_t len)
+    {
+        if( len == 0 || len > TFL_WIRE_BUFFER)
+        {
+          tfStatus = TFL_I2CLENGTH;
+          return false;
+        }
+        Bus.beginTransmission( Addr);
+        Bus.write( nmbr);
+        uint8_t err = Bus.endTransmission();
+        if( err != 0)
+        {
+          tfStatus = tflWriteStatus( err);
+          return false;
+        }
+        if( Bus.requestFrom( ( int)Addr, ( int)len, true) != len)
+        {
+          // Flush any partial reply, and report a timeout
+          // as `TFLWireBus::receive` does
+          while( Bus.available()) Bus.read();
+          tfStatus = TFL_I2CREAD;
+#if defined( WIRE_HAS_TIMEOUT)
+          if( Bus.getWireTimeoutFlag())
+          {
+            Bus.clearWireTimeoutFlag();
+            tfStatus = TFL_TIMEOUT;
+          }
+#endif
+          return false;
+        }
+        for( uint8_t i = 0; i < len; ++i) buf[ i] = ( uint8_t)Bus.read();
+        tfStatus = TFL_READY;
+        return true;
+    }
+
+    bool writeRegs( uint8_t nmbr, const uint8_t buf[], uint8_t len)
+    {
+        if( len == 0 || len > ( TFL_WIRE_BUFFER - 1))
+        {
+          tfStatus = TFL_I2CLENGTH;
+          return false;
+        }
+        Bus.beginTransmission( Addr);
+        Bus.write( nmbr);
+        Bus.write( buf, len);
+        uint8_t err = Bus.endTransmission( true);
+        if( err != 0)
+        {
+          tfStatus = tflWriteStatus( err);
+          return false;
+        }
+        tfStatus = TFL_READY;
+        return true;
+    }
+
+    bool writeReg( uint8_t nmbr, uint8_t data)
+    {
+        return writeRegs( nmbr, &data, 1);
+    }
+
+    // - - - -   Explicit Device Commands   - - - -
+    bool Get_Time( uint16_t &tim)
+    {
+        uint8_t buf[ 2];
+        if( !readRegs( TFL_TICK_LO, buf, 2)) return false;
+        tim = buf[ 0] + ( buf[ 1] << 8);
+        return true;
+    }
+    bool Get_Frame_Rate( uint16_t &frm)
+    {
+        uint8_t buf[ 2];
+        if( !readRegs( TFL_FPS_LO, buf, 2)) return false;
+        frm = buf[ 0] + ( buf[ 1] << 8);
+        return true;
+    }
+    bool Set_Frame_Rate( uint16_t frm)
+    {
+        uint8_t buf[ 2] = { ( uint8_t)frm, ( uint8_t)( frm >> 8)};
+        return writeRegs( TFL_FPS_LO, buf, 2);
+    }
+    bool Set_Enable()    { return writeReg( TFL_DISABLE, 1);}
+    bool Set_Disable()   { return writeReg( TFL_DISABLE, 0);}
+    bool Set_Trig_Mode() { return writeReg( TFL_SET_TRIG_MODE, 1);}
+    bool Set_Cont_Mode() { return writeReg( TFL_SET_TRIG_MODE, 0);}
+    bool Set_Trigger()   { return writeReg( TFL_TRIGGER, 1);}
+    bool Save_Settings() { return writeReg( TFL_SAVE_SETTINGS, 1);}
+    bool Soft_Reset()    { return writeReg( TFL_SOFT_RESET, 2);}
+    bool Hard_Reset()    { return writeReg( TFL_HARD_RESET, 1);}
+
+    // Status code of the last command: READY = 0
+    uint8_t getStatus() const { return tfStatus;}
+    // Set or get the limits used to validate every data frame
+    void Set_Limits( const TFLLimits &lim) { limits = lim;}
+    const TFLLimits &Get_Limits() const    { return limits;}
+    // The fixed address, for use with other library objects
+    static constexpr uint8_t address() { return Addr;}
+
+  private:
+    uint8_t tfStatus;
+    TFLLimits limits;
+
+    bool decode( const uint8_t buf[], int16_t &dist, int16_t &flux, int16_t &temp)
+    {
+        dist = buf[ 0] + ( buf[ 1] << 8);
+        flux = buf[ 2] + ( buf[ 3] << 8);
+        temp = buf[ 4] + ( buf[ 5] << 8);
+        tfStatus = limits.evaluate( dist, flux);
+        return( tfStatus == TFL_READY);
+    }
+};
+
+#endif  // TFLI2CFIXED_H
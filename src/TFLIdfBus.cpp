@@ -0,0 +1,233 @@
+/* File Name: TFLIdfBus.cpp
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: ESP-IDF `i2c_master` transport for the TFLI2C library.
+ *
+ *  The driver calls return `ESP_ERR_TIMEOUT` for a transaction that
+ *  timed out, which is passed back as `TFL_TIMEOUT`.  Any other error,
+ *  such as a device that does not acknowledge, is passed back as
+ *  `TFL_I2CWRITE` or `TFL_I2CREAD`.
+ *
+ *  With `setAsync`, the driver calls `onDone` from its interrupt at
+ *  the end of each transfer.  The transfers end in the order they
+ *  were queued, and each call that waits first lets a queued
+ *  background receive end, so `onDone` can tell the two apart.
+ */
+
+#include <TFLIdfBus.h>
+
+#if defined( ESP_PLATFORM) && !defined( ARDUINO)
+
+#include "esp_timer.h"
+
+static uint8_t idfStatus( esp_err_t err, uint8_t fail)
+{
+    if( err == ESP_OK) return TFL_READY;
+    return( err == ESP_ERR_TIMEOUT) ? TFL_TIMEOUT : fail;
+}
+
+// Constructor/Destructor
+TFLIdfBus::TFLIdfBus( i2c_master_bus_handle_t _bus, uint32_t hz)
+{
+    bus = _bus;
+    clock = hz;
+    timeoutMs = TFL_IDF_TIMEOUT_MS;
+    devNext = 0;
+    memset( dev, 0, sizeof( dev));
+    async = false;
+    bgBusy = false;
+    bgStatus = TFL_READY;
+    fgEvent = I2C_EVENT_DONE;
+    bgStart = 0;
+}
+
+TFLIdfBus::~TFLIdfBus()
+{
+    removeAll();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              DEVICE HANDLES
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Handle of the device at `addr`, added to the bus the first time.
+// When all slots are taken the oldest handle is removed.
+i2c_master_dev_handle_t TFLIdfBus::handle( uint8_t addr)
+{
+    for( uint8_t i = 0; i < TFL_IDF_DEVICES; ++i)
+    {
+      if( dev[ i].addr == addr) return dev[ i].handle;
+    }
+
+    IdfDevice &d = dev[ devNext];
+    devNext = ( devNext + 1) % TFL_IDF_DEVICES;
+    if( d.addr != 0) i2c_master_bus_rm_device( d.handle);
+    d.addr = 0;
+
+    i2c_device_config_t cfg;
+    memset( &cfg, 0, sizeof( cfg));
+    cfg.dev_addr_length = I2C_ADDR_BIT_LEN_7;
+    cfg.device_address = addr;
+    cfg.scl_speed_hz = clock;
+    if( i2c_master_bus_add_device( bus, &cfg, &d.handle) != ESP_OK) return NULL;
+    if( async)
+    {
+      i2c_master_event_callbacks_t cbs;
+      memset( &cbs, 0, sizeof( cbs));
+      cbs.on_trans_done = onDone;
+      if( i2c_master_register_event_callbacks( d.handle, &cbs, this) != ESP_OK)
+      {
+        i2c_master_bus_rm_device( d.handle);
+        return NULL;
+      }
+    }
+    d.addr = addr;
+    return d.handle;
+}
+
+void TFLIdfBus::removeAll()
+{
+    for( uint8_t i = 0; i < TFL_IDF_DEVICES; ++i)
+    {
+      if( dev[ i].addr != 0) i2c_master_bus_rm_device( dev[ i].handle);
+      dev[ i].addr = 0;
+    }
+    devNext = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              QUEUED TRANSFERS
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+// End of a transfer, from the interrupt of the driver
+bool IRAM_ATTR TFLIdfBus::onDone( i2c_master_dev_handle_t h,
+                                  const i2c_master_event_data_t *evt, void *arg)
+{
+    ( void)h;
+    TFLIdfBus *self = ( TFLIdfBus *)arg;
+    if( self->bgBusy)
+    {
+      self->bgStatus = ( evt->event == I2C_EVENT_DONE) ? TFL_READY : TFL_I2CREAD;
+      self->bgBusy = false;
+    }
+    else self->fgEvent = evt->event;
+    return false;            // no task woken
+}
+
+// Let a queued background receive end before another transfer
+void TFLIdfBus::settle()
+{
+    if( !bgBusy) return;
+    if( i2c_master_bus_wait_all_done( bus, timeoutMs) != ESP_OK && bgBusy)
+    {
+      bgBusy = false;
+      bgStatus = TFL_TIMEOUT;
+    }
+}
+
+// Status of a transfer.  A queued transfer is waited for.
+uint8_t TFLIdfBus::finish( esp_err_t err, uint8_t fail)
+{
+    if( err != ESP_OK || !async) return idfStatus( err, fail);
+    err = i2c_master_bus_wait_all_done( bus, timeoutMs);
+    if( err != ESP_OK) return idfStatus( err, fail);
+    return( fgEvent == I2C_EVENT_DONE) ? TFL_READY : fail;
+}
+
+bool TFLIdfBus::setAsync( bool on)
+{
+    settle();
+    async = on;
+    removeAll();             // handles are added again with the callback
+    return true;
+}
+
+uint8_t TFLIdfBus::startReceive( uint8_t addr, uint8_t *buf, uint8_t len)
+{
+    if( !async) return TFL_INVALID;
+    settle();
+    i2c_master_dev_handle_t h = handle( addr);
+    if( !h) return TFL_I2CREAD;
+    bgBusy = true;
+    bgStart = esp_timer_get_time();
+    esp_err_t err = i2c_master_receive( h, buf, len, timeoutMs);
+    if( err != ESP_OK)
+    {
+      bgBusy = false;
+      return idfStatus( err, TFL_I2CREAD);
+    }
+    return TFL_READY;
+}
+
+// A receive the driver never ends is given up after the timeout
+bool TFLIdfBus::receiveDone( uint8_t &status)
+{
+    if( bgBusy && esp_timer_get_time() - bgStart < ( int64_t)timeoutMs * 1000) return false;
+    settle();
+    status = bgStatus;
+    return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              TRANSACTIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+uint8_t TFLIdfBus::readRegs( uint8_t addr, uint8_t reg, uint8_t *buf, uint8_t len)
+{
+    settle();
+    i2c_master_dev_handle_t h = handle( addr);
+    if( !h) return TFL_I2CWRITE;
+    uint8_t status = finish( i2c_master_transmit( h, &reg, 1, timeoutMs), TFL_I2CWRITE);
+    if( status != TFL_READY) return status;
+    return finish( i2c_master_receive( h, buf, len, timeoutMs), TFL_I2CREAD);
+}
+
+uint8_t TFLIdfBus::writeRegs( uint8_t addr, uint8_t reg, const uint8_t *buf, uint8_t len)
+{
+    if( len >= TFL_IDF_BUFFER) return TFL_I2CLENGTH;
+    settle();
+    i2c_master_dev_handle_t h = handle( addr);
+    if( !h) return TFL_I2CWRITE;
+    uint8_t out[ TFL_IDF_BUFFER];
+    out[ 0] = reg;
+    if( len) memcpy( out + 1, buf, len);
+    return finish( i2c_master_transmit( h, out, 1 + len, timeoutMs), TFL_I2CWRITE);
+}
+
+uint8_t TFLIdfBus::receive( uint8_t addr, uint8_t *buf, uint8_t len)
+{
+    settle();
+    i2c_master_dev_handle_t h = handle( addr);
+    if( !h) return TFL_I2CREAD;
+    return finish( i2c_master_receive( h, buf, len, timeoutMs), TFL_I2CREAD);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              CONTROLS
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+// The clock is a setting of each device handle, so the handles
+// are removed and added again at the new clock when next used.
+bool TFLIdfBus::setClock( uint32_t hz)
+{
+    settle();
+    clock = hz;
+    removeAll();
+    return true;
+}
+
+bool TFLIdfBus::setTimeout( uint32_t us)
+{
+    timeoutMs = ( int)( ( us + 999) / 1000);
+    return true;
+}
+
+// The driver clocks out a stuck device and sends a STOP
+bool TFLIdfBus::recover()
+{
+    if( bgBusy)
+    {
+      bgBusy = false;
+      bgStatus = TFL_TIMEOUT;
+    }
+    return( i2c_master_bus_reset( bus) == ESP_OK);
+}
+
+#endif  // ESP_PLATFORM && !ARDUINO
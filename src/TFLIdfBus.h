@@ -0,0 +1,98 @@
+/* File Name: TFLIdfBus.h
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: ESP-IDF `i2c_master` transport for the TFLI2C library.
+ *
+ *  For ESP-IDF 5.2 or later without the Arduino core.  The bus is
+ *  created by the application with `i2c_new_master_bus` and given to
+ *  the transport, which adds a device handle for each address the
+ *  first time it is used, up to `TFL_IDF_DEVICES` addresses.  Each
+ *  read is an `i2c_master_transmit` of the register number, ended
+ *  with a STOP, followed by an `i2c_master_receive` of the data, as
+ *  the TF-Luna does not take a repeated start.
+ *
+ *  If the bus was made with a `trans_queue_depth`, the driver queues
+ *  transfers and does them in the background.  Tell the transport so
+ *  with `setAsync( true)` before the first transfer.  `TFLI2C::poll`
+ *  then leaves the frame read to the driver and the CPU is free while
+ *  the bytes are on the wire.  Every other call still waits for its
+ *  transfer, and for a background read queued before it.
+ *
+ *  Typical use:
+ *    i2c_master_bus_handle_t bus;
+ *    i2c_new_master_bus( &busConfig, &bus);
+ *    TFLIdfBus idfBus( bus, 400000);
+ *    TFLI2C tflI2C;
+ *    ...
+ *    tflI2C.Set_Bus( &idfBus);
+ */
+
+#ifndef TFLIDFBUS_H
+#define TFLIDFBUS_H
+
+#include <TFLI2C.h>
+
+#if defined( ESP_PLATFORM) && !defined( ARDUINO)
+
+#include "driver/i2c_master.h"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//      Definitions
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#define TFL_IDF_DEVICES      8   // device handles kept
+#define TFL_IDF_BUFFER      32   // largest transfer
+#define TFL_IDF_TIMEOUT_MS  50   // default transaction timeout
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                 OBJECT CLASS DEFINITIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+class TFLIdfBus : public TFLBus
+{
+  public:
+    TFLIdfBus( i2c_master_bus_handle_t bus, uint32_t hz = 100000UL);
+    ~TFLIdfBus();
+
+    uint8_t readRegs( uint8_t addr, uint8_t reg, uint8_t *buf, uint8_t len);
+    uint8_t writeRegs( uint8_t addr, uint8_t reg, const uint8_t *buf, uint8_t len);
+    uint8_t receive( uint8_t addr, uint8_t *buf, uint8_t len);
+    uint8_t maxLength() const { return TFL_IDF_BUFFER;}
+    bool setClock( uint32_t hz);
+    bool setTimeout( uint32_t us);
+    bool recover();
+    // The bus was made with a `trans_queue_depth`
+    bool setAsync( bool on);
+    uint8_t startReceive( uint8_t addr, uint8_t *buf, uint8_t len);
+    bool receiveDone( uint8_t &status);
+
+  private:
+    struct IdfDevice
+    {
+        uint8_t addr;                    // I2C address, 0 = slot unused
+        i2c_master_dev_handle_t handle;
+    };
+    i2c_master_bus_handle_t bus;
+    IdfDevice dev[ TFL_IDF_DEVICES];
+    uint8_t  devNext;        // slot to reuse when all are taken
+    uint32_t clock;          // clock of new device handles
+    int      timeoutMs;
+
+    bool     async;              // transfers are queued
+    volatile bool    bgBusy;     // a background receive is queued
+    volatile uint8_t bgStatus;   // status of the background receive
+    volatile uint8_t fgEvent;    // event of the last waited transfer
+    int64_t  bgStart;            // `esp_timer` time of the background receive
+
+    i2c_master_dev_handle_t handle( uint8_t addr);
+    void removeAll();
+    uint8_t finish( esp_err_t err, uint8_t fail);
+    void settle();
+    static bool onDone( i2c_master_dev_handle_t h,
+                        const i2c_master_event_data_t *evt, void *arg);
+};
+
+#endif  // ESP_PLATFORM && !ARDUINO
+
+#endif  // TFLIDFBUS_H
@@ -0,0 +1,181 @@
+/* File Name: TFLLinuxBus.cpp
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Linux `/dev/i2c-N` transport for the TFLI2C library.
+ *
+ *  A failed ioctl sets `errno`.  `ETIMEDOUT` is passed back as
+ *  `TFL_TIMEOUT`.  A device that does not acknowledge gives `ENXIO`
+ *  or `EREMOTEIO` and is passed back as `TFL_I2CWRITE`, because the
+ *  address is the first byte sent.  Any other error is passed back
+ *  as the read or write error of the call.
+ */
+
+#include <TFLLinuxBus.h>
+
+#if defined( __linux__) && !defined( ARDUINO)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+// Constructor/Destructor
+TFLLinuxBus::TFLLinuxBus()
+{
+    fd = -1;
+    calls = 0;
+    mangling = false;
+}
+
+TFLLinuxBus::~TFLLinuxBus()
+{
+    end();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              OPEN AND CLOSE
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TFLLinuxBus::begin( int bus)
+{
+    char path[ 24];
+    snprintf( path, sizeof( path), "/dev/i2c-%d", bus);
+    return begin( path);
+}
+
+bool TFLLinuxBus::begin( const char *path)
+{
+    end();
+    fd = open( path, O_RDWR);
+    if( fd < 0) return false;
+    unsigned long funcs = 0;
+    mangling = ( ioctl( fd, I2C_FUNCS, &funcs) == 0) &&
+               ( funcs & I2C_FUNC_PROTOCOL_MANGLING);
+    return true;
+}
+
+void TFLLinuxBus::end()
+{
+    if( fd >= 0) close( fd);
+    fd = -1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              TRANSACTIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Send `n` messages in one combined transaction.  Only a failed
+// ioctl sets `errno`; a short transfer is the error of the call.
+uint8_t TFLLinuxBus::transfer( void *msgs, uint8_t n, uint8_t fail)
+{
+    if( fd < 0) return fail;
+    struct i2c_rdwr_ioctl_data data;
+    data.msgs = ( struct i2c_msg *)msgs;
+    data.nmsgs = n;
+    ++calls;
+    int done = ioctl( fd, I2C_RDWR, &data);
+    if( done == ( int)n) return TFL_READY;
+    if( done >= 0) return fail;
+    if( errno == ETIMEDOUT) return TFL_TIMEOUT;
+    if( errno == ENXIO || errno == EREMOTEIO) return TFL_I2CWRITE;
+    return fail;
+}
+
+// The register write ends with a STOP, in the same ioctl as the
+// read if the adapter can, otherwise in an ioctl of its own
+uint8_t TFLLinuxBus::readRegs( uint8_t addr, uint8_t reg, uint8_t *buf, uint8_t len)
+{
+    struct i2c_msg msg[ 2];
+    msg[ 0].addr = addr;
+    msg[ 0].flags = mangling ? I2C_M_STOP : 0;
+    msg[ 0].len = 1;
+    msg[ 0].buf = &reg;
+    msg[ 1].addr = addr;
+    msg[ 1].flags = I2C_M_RD;
+    msg[ 1].len = len;
+    msg[ 1].buf = buf;
+    if( mangling) return transfer( msg, 2, TFL_I2CREAD);
+
+    uint8_t status = transfer( msg, 1, TFL_I2CWRITE);
+    if( status != TFL_READY) return status;
+    return transfer( msg + 1, 1, TFL_I2CREAD);
+}
+
+uint8_t TFLLinuxBus::writeRegs( uint8_t addr, uint8_t reg, const uint8_t *buf, uint8_t len)
+{
+    if( len >= TFL_LINUX_BUFFER) return TFL_I2CLENGTH;
+    uint8_t out[ TFL_LINUX_BUFFER];
+    out[ 0] = reg;
+    if( len) memcpy( out + 1, buf, len);
+
+    struct i2c_msg msg;
+    msg.addr = addr;
+    msg.flags = 0;
+    msg.len = 1 + len;
+    msg.buf = out;
+    return transfer( &msg, 1, TFL_I2CWRITE);
+}
+
+uint8_t TFLLinuxBus::receive( uint8_t addr, uint8_t *buf, uint8_t len)
+{
+    struct i2c_msg msg;
+    msg.addr = addr;
+    msg.flags = I2C_M_RD;
+    msg.len = len;
+    msg.buf = buf;
+    return transfer( &msg, 1, TFL_I2CREAD);
+}
+
+// Read the same registers of `n` devices, `TFL_LINUX_MULTI` devices
+// to an ioctl.  If an ioctl fails, read its devices one at a time.
+// Without `I2C_M_STOP` every device is read on its own.
+void TFLLinuxBus::readMulti( const uint8_t addr[], uint8_t n, uint8_t reg,
+                             uint8_t *buf, uint8_t len, uint8_t status[])
+{
+    if( !mangling)
+    {
+      TFLBus::readMulti( addr, n, reg, buf, len, status);
+      return;
+    }
+
+    struct i2c_msg msg[ 2 * TFL_LINUX_MULTI];
+
+    for( uint8_t first = 0; first < n; first += TFL_LINUX_MULTI)
+    {
+      uint8_t k = n - first;
+      if( k > TFL_LINUX_MULTI) k = TFL_LINUX_MULTI;
+      for( uint8_t i = 0; i < k; ++i)
+      {
+        msg[ 2 * i].addr = addr[ first + i];
+        msg[ 2 * i].flags = I2C_M_STOP;
+        msg[ 2 * i].len = 1;
+        msg[ 2 * i].buf = &reg;
+        msg[ 2 * i + 1].addr = addr[ first + i];
+        msg[ 2 * i + 1].flags = I2C_M_RD;
+        msg[ 2 * i + 1].len = len;
+        msg[ 2 * i + 1].buf = buf + ( first + i) * len;
+      }
+      if( transfer( msg, 2 * k, TFL_I2CREAD) == TFL_READY)
+      {
+        memset( status + first, TFL_READY, k);
+        continue;
+      }
+      for( uint8_t i = first; i < first + k; ++i)
+      {
+        status[ i] = readRegs( addr[ i], reg, buf + i * len, len);
+      }
+    }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              CONTROLS
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TFLLinuxBus::setTimeout( uint32_t us)
+{
+    if( fd < 0) return false;
+    unsigned long steps = ( us + 9999UL) / 10000UL;   // 10ms steps
+    return( ioctl( fd, I2C_TIMEOUT, steps) == 0);
+}
+
+#endif  // __linux__ && !ARDUINO
@@ -0,0 +1,84 @@
+/* File Name: TFLLinuxBus.h
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Linux `/dev/i2c-N` transport for the TFLI2C library.
+ *
+ *  For a Raspberry Pi, Jetson or other Linux host driving TF-Luna
+ *  devices from user space.  The TF-Luna does not take a repeated
+ *  start, so the register number is written with a STOP before the
+ *  data is read.  If the adapter can send a STOP inside a combined
+ *  transaction, `I2C_FUNC_PROTOCOL_MANGLING`, every read is one
+ *  `I2C_RDWR` ioctl of two messages, the first flagged `I2C_M_STOP`,
+ *  so a data frame costs one system call.  `readMulti` then puts the
+ *  messages of up to `TFL_LINUX_MULTI` devices into one ioctl, so that
+ *  `TFLI2C::getFrames` reads eight devices in one system call.  Without
+ *  it, the write and the read are two ioctls and `readMulti` reads the
+ *  devices one at a time.
+ *
+ *  If any message of a combined ioctl fails, the kernel does not say
+ *  which one, so the devices of that ioctl are read again one at a
+ *  time to find the status of each.  Keep devices that stopped
+ *  answering out of the batch, as `TFLI2CArray` does.
+ *
+ *  The bus clock is set by the kernel device tree and cannot be changed
+ *  here.  `setTimeout` sets the adapter timeout, in steps of 10ms.
+ *
+ *  Typical use:
+ *    TFLLinuxBus linuxBus;
+ *    TFLI2C tflI2C;
+ *    ...
+ *    if( !linuxBus.begin( 1)) ...         // "/dev/i2c-1"
+ *    tflI2C.Set_Bus( &linuxBus);
+ */
+
+#ifndef TFLLINUXBUS_H
+#define TFLLINUXBUS_H
+
+#include <TFLI2C.h>
+
+#if defined( __linux__) && !defined( ARDUINO)
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//      Definitions
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#define TFL_LINUX_MULTI     21   // devices in one ioctl: 42 messages,
+                                 // the kernel `I2C_RDWR_IOCTL_MAX_MSGS`
+#define TFL_LINUX_BUFFER    32   // largest transfer
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                 OBJECT CLASS DEFINITIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+class TFLLinuxBus : public TFLBus
+{
+  public:
+    TFLLinuxBus();
+    ~TFLLinuxBus();
+
+    // Open `/dev/i2c-<bus>`, or the device file `path`
+    bool begin( int bus);
+    bool begin( const char *path);
+    void end();
+
+    uint8_t readRegs( uint8_t addr, uint8_t reg, uint8_t *buf, uint8_t len);
+    uint8_t writeRegs( uint8_t addr, uint8_t reg, const uint8_t *buf, uint8_t len);
+    uint8_t receive( uint8_t addr, uint8_t *buf, uint8_t len);
+    uint8_t maxLength() const { return TFL_LINUX_BUFFER;}
+    bool setTimeout( uint32_t us);
+    void readMulti( const uint8_t addr[], uint8_t n, uint8_t reg,
+                    uint8_t *buf, uint8_t len, uint8_t status[]);
+
+    uint32_t calls;          // ioctl calls made
+
+  private:
+    int fd;                  // open device file, or -1
+    bool mangling;           // adapter takes `I2C_M_STOP`
+
+    uint8_t transfer( void *msgs, uint8_t n, uint8_t fail);
+};
+
+#endif  // __linux__ && !ARDUINO
+
+#endif  // TFLLINUXBUS_H
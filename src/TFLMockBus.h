@@ -0,0 +1,181 @@
+/* File Name: TFLMockBus.h
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: In-memory register map transport for testing the TFLI2C
+ *            library without a sensor.
+ *
+ *  A `TFLMockBus` holds a register map for each of up to
+ *  `TFL_MOCK_DEVICES` devices.  It answers reads and writes exactly as
+ *  a TF-Luna does: the register pointer is written first and moves on
+ *  with every byte.  A device that was not added does not acknowledge.
+ *  The next transactions can be made to fail with `failNext`.
+ *
+ *  Typical use:
+ *    TFLMockBus mock;
+ *    TFLI2C tflI2C;
+ *    ...
+ *    uint8_t *reg = mock.attach( 0x10);
+ *    reg[ TFL_DIST_LO] = 100;             // 100cm
+ *    reg[ TFL_FLUX_LO] = 200;
+ *    tflI2C.Set_Bus( &mock);
+ *
+ *  The register map of a device is plain memory, so a test can change
+ *  it between reads.  A subclass can model a device by overriding
+ *  `reading`, called before each read, and `written`, called for each
+ *  register written.
+ */
+
+#ifndef TFLMOCKBUS_H
+#define TFLMOCKBUS_H
+
+#include <TFLI2C.h>
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//      Definitions
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#define TFL_MOCK_DEVICES     8   // devices on one mock bus
+#define TFL_MOCK_REGS     0x40   // registers of each device
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                 OBJECT CLASS DEFINITIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+class TFLMockBus : public TFLBus
+{
+  public:
+    TFLMockBus() { reset();}
+    virtual ~TFLMockBus() {}
+
+    // Remove all devices and clear the counters
+    void reset()
+    {
+        memset( dev, 0, sizeof( dev));
+        failStatus = TFL_READY;
+        failCount = 0;
+        reads = 0;
+        writes = 0;
+        clock = 0;
+    }
+
+    // Add a device at `addr` with all registers zero.  Returns its
+    // register map, or NULL if the bus is full.
+    uint8_t *attach( uint8_t addr)
+    {
+        MockDevice *d = find( addr);
+        if( !d) d = find( 0);
+        if( !d) return NULL;
+        memset( d, 0, sizeof( MockDevice));
+        d->addr = addr;
+        return d->reg;
+    }
+
+    // Register map of the device at `addr`, or NULL if none
+    uint8_t *regs( uint8_t addr)
+    {
+        MockDevice *d = find( addr);
+        return d ? d->reg : NULL;
+    }
+
+    // Move the device at `from` to address `to`, keeping its registers.
+    // Returns false if there is no device at `from` or `to` is taken.
+    bool move( uint8_t from, uint8_t to)
+    {
+        MockDevice *d = find( from);
+        if( !d || from == 0 || to == 0 || find( to)) return false;
+        d->addr = to;
+        return true;
+    }
+
+    // Fail the next `count` transactions with `status`
+    void failNext( uint8_t status, uint16_t count = 1)
+    {
+        failStatus = status;
+        failCount = count;
+    }
+
+    uint32_t reads;          // read transactions answered
+    uint32_t writes;         // write transactions answered
+
+    // - - -   TFLBus   - - -
+    uint8_t readRegs( uint8_t addr, uint8_t reg, uint8_t *buf, uint8_t len)
+    {
+        uint8_t status = writeRegs( addr, reg, NULL, 0);
+        if( status != TFL_READY) return status;
+        return receive( addr, buf, len);
+    }
+
+    uint8_t writeRegs( uint8_t addr, uint8_t reg, const uint8_t *buf, uint8_t len)
+    {
+        MockDevice *d = find( addr);
+        if( !d || addr == 0) return TFL_I2CWRITE;    // no acknowledge
+        if( failing()) return failStatus;
+        ++writes;
+        d->ptr = reg % TFL_MOCK_REGS;
+        for( uint8_t i = 0; i < len; ++i)
+        {
+          uint8_t r = d->ptr;
+          d->reg[ r] = buf[ i];
+          d->ptr = ( r + 1) % TFL_MOCK_REGS;
+          written( addr, r, buf[ i]);
+        }
+        return TFL_READY;
+    }
+
+    uint8_t receive( uint8_t addr, uint8_t *buf, uint8_t len)
+    {
+        MockDevice *d = find( addr);
+        if( !d || addr == 0) return TFL_I2CREAD;
+        if( failing()) return failStatus;
+        ++reads;
+        reading( addr);
+        for( uint8_t i = 0; i < len; ++i)
+        {
+          buf[ i] = d->reg[ d->ptr];
+          d->ptr = ( d->ptr + 1) % TFL_MOCK_REGS;
+        }
+        return TFL_READY;
+    }
+
+    bool setClock( uint32_t hz) { clock = hz; return true;}
+    uint32_t clock;          // last clock set
+
+  protected:
+    // Called before the registers of device `addr` are read
+    virtual void reading( uint8_t addr) { ( void)addr;}
+    // Called after register `reg` of device `addr` is written
+    virtual void written( uint8_t addr, uint8_t reg, uint8_t value)
+    {
+        ( void)addr; ( void)reg; ( void)value;
+    }
+
+  private:
+    struct MockDevice
+    {
+        uint8_t addr;                    // I2C address, 0 = slot unused
+        uint8_t ptr;                     // register pointer
+        uint8_t reg[ TFL_MOCK_REGS];
+    };
+    MockDevice dev[ TFL_MOCK_DEVICES];
+    uint8_t  failStatus;
+    uint16_t failCount;
+
+    MockDevice *find( uint8_t addr)
+    {
+        for( uint8_t i = 0; i < TFL_MOCK_DEVICES; ++i)
+        {
+          if( dev[ i].addr == addr) return &dev[ i];
+        }
+        return NULL;
+    }
+
+    bool failing()
+    {
+        if( failCount == 0) return false;
+        --failCount;
+        return true;
+    }
+};
+
+#endif  // TFLMOCKBUS_H
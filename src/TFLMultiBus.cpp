@@ -0,0 +1,238 @@
+/* File Name: TFLMultiBus.cpp
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Reads TF-Luna devices on several I2C buses at once and
+ *            merges their frames into one time ordered stream.
+ *
+ *  Without tasks, `update()` reads the buses one after the other: the
+ *  Wire library waits for each transaction, so the buses take turns
+ *  rather than overlap.  With tasks, a lane waits one tick of the
+ *  scheduler when none of its devices is due, so that lower priority
+ *  tasks can run.
+ */
+
+#include <TFLMultiBus.h>
+
+// Constructor/Destructor
+TFLMultiBus::TFLMultiBus()
+{
+    laneCount = 0;
+    tasks = false;
+    for( uint8_t i = 0; i < TFL_BUS_LANES; ++i)
+    {
+      lane[ i].bus = i;
+      lane[ i].run = false;
+      lane[ i].running = false;
+    }
+}
+
+TFLMultiBus::~TFLMultiBus()
+{
+    stopTasks();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              BUSES AND DEVICES
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+int8_t TFLMultiBus::addBus( TFLBus &bus)
+{
+    if( laneCount >= TFL_BUS_LANES) return -1;
+    lane[ laneCount].tfl.Set_Bus( &bus);
+    return laneCount++;
+}
+
+#if defined( ARDUINO)
+int8_t TFLMultiBus::addBus( TwoWire &wire)
+{
+    if( laneCount >= TFL_BUS_LANES) return -1;
+    lane[ laneCount].tfl.Set_Bus( &wire);
+    return laneCount++;
+}
+#endif
+
+bool TFLMultiBus::addDevice( uint8_t bus, uint8_t addr)
+{
+    if( bus >= laneCount) return false;
+    return lane[ bus].array.addDevice( addr);
+}
+
+int8_t TFLMultiBus::addDevice( uint8_t addr)
+{
+    int8_t pick = -1;
+    for( uint8_t b = 0; b < laneCount; ++b)
+    {
+      TFLI2CArray &a = lane[ b].array;
+      if( a.count() >= TFL_MAX_DEVICES) continue;
+      bool taken = false;
+      for( uint8_t i = 0; i < a.count(); ++i)
+      {
+        if( a.device( i).addr == addr) taken = true;
+      }
+      if( taken) continue;
+      if( pick < 0 || a.count() < lane[ pick].array.count()) pick = b;
+    }
+    if( pick >= 0) lane[ pick].array.addDevice( addr);
+    return pick;
+}
+
+uint8_t TFLMultiBus::begin()
+{
+    uint8_t online = 0;
+    for( uint8_t b = 0; b < laneCount; ++b)
+    {
+      lane[ b].array.setFreshOnly( true);
+      online += lane[ b].array.begin();
+    }
+    return online;
+}
+
+uint8_t TFLMultiBus::busCount()
+{
+    return laneCount;
+}
+
+TFLI2CArray &TFLMultiBus::array( uint8_t bus)
+{
+    return lane[ bus].array;
+}
+
+TFLI2C &TFLMultiBus::tfl( uint8_t bus)
+{
+    return lane[ bus].tfl;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              ACQUISITION
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Read the most overdue device of lane `l` and queue a new frame.
+// Returns true if a frame was queued.
+bool TFLMultiBus::step( Lane &l)
+{
+    uint32_t start = micros();
+    int8_t i = l.array.update();
+    if( i < 0) return false;
+    uint32_t end = micros();
+
+    TFLStamped s;
+    if( !l.array.getData( i, s.frame.dist, s.frame.flux, s.frame.temp)) return false;
+    TFLDevice &d = l.array.device( i);
+    s.frame.tick = d.tick;
+    s.frame.addr = d.addr;
+    s.frame.status = tflStatus( d.status);
+    s.us = start + ( end - start) / 2;
+    s.bus = l.bus;
+    return l.ring.push( s);
+}
+
+// A lane with a task of its own is read by that task only, as its
+// ring takes frames from a single producer
+uint8_t TFLMultiBus::update()
+{
+    uint8_t n = 0;
+    for( uint8_t b = 0; b < laneCount; ++b)
+    {
+      if( lane[ b].running) continue;
+      if( step( lane[ b])) ++n;
+    }
+    return n;
+}
+
+#if defined( TFL_MULTI_TASKS)
+void TFLMultiBus::laneTask( void *arg)
+{
+    Lane &l = *( Lane *)arg;
+    while( l.run)
+    {
+      if( !step( l)) vTaskDelay( 1);
+    }
+    l.running = false;
+    vTaskDelete( NULL);
+}
+#endif
+
+bool TFLMultiBus::startTasks( uint8_t priority)
+{
+#if defined( TFL_MULTI_TASKS)
+    bool ok = true;
+    for( uint8_t b = 0; b < laneCount; ++b)
+    {
+      Lane &l = lane[ b];
+      if( l.running) continue;       // its task is already reading
+      l.run = true;
+      l.running = true;
+      if( xTaskCreatePinnedToCore( laneTask, "tflLane", TFL_LANE_STACK, &l,
+                                   priority, NULL, b % portNUM_PROCESSORS) != pdPASS)
+      {
+        l.run = false;
+        l.running = false;
+        ok = false;
+      }
+    }
+    tasks = true;
+    return ok;
+#else
+    ( void)priority;
+    return false;
+#endif
+}
+
+// Ask every lane task to end and wait until it has
+void TFLMultiBus::stopTasks()
+{
+#if defined( TFL_MULTI_TASKS)
+    if( !tasks) return;
+    for( uint8_t b = 0; b < laneCount; ++b) lane[ b].run = false;
+    for( uint8_t b = 0; b < laneCount; ++b)
+    {
+      while( lane[ b].running) vTaskDelay( 1);
+    }
+    tasks = false;
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              MERGED FRAMES
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+uint16_t TFLMultiBus::available()
+{
+    uint16_t n = 0;
+    for( uint8_t b = 0; b < laneCount; ++b) n += lane[ b].ring.count();
+    return n;
+}
+
+// Take the oldest frame at the head of the lanes.  Stamps are
+// compared by signed difference to survive the roll-over of `micros()`.
+bool TFLMultiBus::read( TFLStamped &out)
+{
+    int8_t pick = -1;
+    const TFLStamped *oldest = NULL;
+    for( uint8_t b = 0; b < laneCount; ++b)
+    {
+      const TFLStamped *s = lane[ b].ring.peek();
+      if( !s) continue;
+      if( !oldest || ( int32_t)( s->us - oldest->us) < 0)
+      {
+        oldest = s;
+        pick = b;
+      }
+    }
+    if( pick < 0) return false;
+    out = *oldest;
+    lane[ pick].ring.discard();
+    return true;
+}
+
+uint16_t TFLMultiBus::readBatch( TFLStamped out[], uint16_t max)
+{
+    uint16_t n = 0;
+    while( n < max && read( out[ n])) ++n;
+    return n;
+}
+
+uint32_t TFLMultiBus::getOverruns()
+{
+    uint32_t n = 0;
+    for( uint8_t b = 0; b < laneCount; ++b) n += lane[ b].ring.getOverruns();
+    return n;
+}
@@ -0,0 +1,145 @@
+/* File Name: TFLMultiBus.h
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Reads TF-Luna devices on several I2C buses at once and
+ *            merges their frames into one time ordered stream.
+ *
+ *  Boards such as the ESP32 and Teensy have two or three I2C
+ *  controllers.  Splitting the devices across them multiplies the
+ *  number of frames a second that can be read, and lets devices with
+ *  the same address work side by side on different buses.
+ *
+ *  A `TFLMultiBus` has one lane for each bus, up to `TFL_BUS_LANES`.
+ *  Each lane has its own `TFLI2C` and `TFLI2CArray`, so each bus keeps
+ *  its own schedule, status and offline devices.  A new frame is
+ *  stamped with `micros()` at the middle of its read, one clock for all
+ *  buses, and queued in the `TFLRing` of its lane.
+ *
+ *  `update()` reads the most overdue device of every bus in turn, from
+ *  the main loop.  On ESP32, `startTasks()` instead runs each lane in
+ *  a FreeRTOS task of its own, on alternate cores, so the controllers
+ *  work in parallel.  Each lane ring then has one producer and one
+ *  consumer and needs no lock.
+ *
+ *  `read()` and `readBatch()` merge the lanes, oldest stamp first.
+ *  A slow lane may still deliver a frame older than one already read,
+ *  so compare stamps, not the order of arrival, to line frames up.
+ *
+ *  Typical use:
+ *    TFLMultiBus multi;
+ *    ...
+ *    multi.addBus( Wire);
+ *    multi.addBus( Wire1);
+ *    multi.addDevice( 0x10);          // put on the bus with the fewest
+ *    multi.addDevice( 0x10);          // the other bus
+ *    multi.begin();
+ *    multi.startTasks();              // ESP32, or call `update()`
+ *    ...
+ *    TFLStamped s;
+ *    while( multi.read( s)) ...       // s.bus, s.us, s.frame
+ */
+
+#ifndef TFLMULTIBUS_H
+#define TFLMULTIBUS_H
+
+#include <TFLI2C.h>
+#include <TFLI2CArray.h>
+#include <TFLRing.h>
+
+#if defined( ESP_PLATFORM)
+  #include "freertos/FreeRTOS.h"
+  #include "freertos/task.h"
+  #define TFL_MULTI_TASKS          // lanes can run in tasks of their own
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//      Definitions
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#define TFL_BUS_LANES        3   // buses of one `TFLMultiBus`
+#define TFL_LANE_RING       16   // frames waiting in each lane
+#define TFL_LANE_STACK    3072   // stack of a lane task, in bytes
+
+// One frame with the time and bus it was read on
+struct TFLStamped
+{
+    TFLFrame frame;      // data, tick, address and status
+    uint32_t us;         // `micros()` at the middle of the read
+    uint8_t  bus;        // lane the device is on
+};
+
+// The frame of a stamped item, for `TFLTelemetry::drain`
+inline const TFLFrame &tflFrameOf( const TFLStamped &s) { return s.frame;}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                 OBJECT CLASS DEFINITIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+class TFLMultiBus
+{
+  public:
+    TFLMultiBus();
+    ~TFLMultiBus();
+
+    // Add a bus.  Returns its lane number, or -1 if all are taken.
+    int8_t addBus( TFLBus &bus);
+#if defined( ARDUINO)
+    int8_t addBus( TwoWire &wire);
+#endif
+
+    // Put a device on bus `bus`.  Returns false if its table is full.
+    bool addDevice( uint8_t bus, uint8_t addr);
+    // Put a device on the bus with the fewest devices that does not
+    // have one at `addr` yet.  Returns the bus, or -1 if none has room.
+    int8_t addDevice( uint8_t addr);
+    // Probe every device of every bus.
+    // Returns the number of devices that are online.
+    uint8_t begin();
+
+    // Read the most overdue device of each bus that has no task.
+    // Returns the number of frames queued.
+    uint8_t update();
+    // Run each bus in a task of its own.  True if all tasks started.
+    // A bus whose task did not start is still read by `update`, and
+    // a later call tries to start it again.
+    bool startTasks( uint8_t priority = 1);
+    void stopTasks();
+
+    // Frames waiting on all buses
+    uint16_t available();
+    // Take the frame with the oldest stamp.  False if none is waiting.
+    bool read( TFLStamped &out);
+    // Take up to `max` frames, oldest stamp first.
+    // Returns the number of frames taken.
+    uint16_t readBatch( TFLStamped out[], uint16_t max);
+    // Frames dropped because a lane ring was full
+    uint32_t getOverruns();
+
+    uint8_t busCount();
+    // Device table and library object of a bus, for its settings
+    TFLI2CArray &array( uint8_t bus);
+    TFLI2C &tfl( uint8_t bus);
+
+  private:
+    struct Lane
+    {
+        Lane() : array( tfl) {}
+        TFLI2C tfl;
+        TFLI2CArray array;
+        TFLRing< TFL_LANE_RING, TFLStamped> ring;
+        uint8_t bus;
+        volatile bool run;               // task keeps going while set
+        volatile bool running;           // task has not ended yet
+    };
+    Lane lane[ TFL_BUS_LANES];
+    uint8_t laneCount;
+    bool tasks;                          // some lanes may run in tasks
+
+    static bool step( Lane &l);
+#if defined( TFL_MULTI_TASKS)
+    static void laneTask( void *arg);
+#endif
+};
+
+#endif  // TFLMULTIBUS_H
@@ -0,0 +1,195 @@
+/* File Name: TFLPower.cpp
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Duty-cycled, low power data acquisition for the Benewake
+ *            TF-Luna Lidar sensor configured for the I2C interface.
+ *
+ *  Typical use:
+ *    TFLI2C tflI2C;
+ *    TFLPower tflPower( tflI2C);
+ *    ...
+ *    tflPower.begin( TFL_DEF_ADR, TFL_DUTY_SLEEP, 10000);  // every 10s
+ *    ...
+ *    if( tflPower.update() && tflPower.getData( dist, flux, temp)) ...
+ */
+
+#include <TFLPower.h>
+
+// Schedule states
+#define TFL_DUTY_IDLE        0   // waiting for the next sample
+#define TFL_DUTY_AWAKE       1   // woken or triggered, waiting for a frame
+
+// Constructor/Destructor
+TFLPower::TFLPower( TFLI2C &_tfl) : tfl( _tfl)
+{
+    addr = TFL_DEF_ADR;
+    mode = TFL_DUTY_LOPWR;
+    state = TFL_DUTY_IDLE;
+    period = 1000;
+    convUs = TFL_CONV_US;
+    activeMa = TFL_ACTIVE_MA;
+    idleMa = TFL_IDLE_MA;
+    fresh = false;
+    clearStats();
+}
+TFLPower::~TFLPower(){}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              SET UP
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TFLPower::begin( uint8_t _addr, uint8_t _mode, uint32_t _period, uint16_t fps)
+{
+    addr = _addr;
+    mode = _mode;
+    period = _period;
+    state = TFL_DUTY_IDLE;
+    fresh = false;
+    tick = 0;
+    clearStats();
+
+    bool ok;
+    if( mode == TFL_DUTY_LOPWR)
+    {
+      ok = tfl.Set_Cont_Mode( addr) && tfl.Set_Frame_Rate( fps, addr) &&
+           tfl.Set_Lo_Power( addr) && tfl.Set_Enable( addr);
+    }
+    else if( mode == TFL_DUTY_TRIGGER)
+    {
+      ok = tfl.Set_Normal_Power( addr) && tfl.Set_Trig_Mode( addr) &&
+           tfl.Set_Enable( addr);
+    }
+    else
+    {
+      ok = tfl.Set_Normal_Power( addr) && tfl.Set_Cont_Mode( addr) &&
+           tfl.Set_Disable( addr);
+    }
+    due = millis();
+    return ok;
+}
+
+bool TFLPower::end()
+{
+    state = TFL_DUTY_IDLE;
+    return( tfl.Set_Normal_Power( addr) && tfl.Set_Cont_Mode( addr) &&
+            tfl.Set_Enable( addr));
+}
+
+void TFLPower::setCurrent( uint16_t _activeMa, uint16_t _idleMa)
+{
+    activeMa = _activeMa;
+    idleMa = _idleMa;
+}
+
+void TFLPower::setConvTime( uint32_t _convUs)
+{
+    convUs = _convUs;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              SCHEDULE
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TFLPower::update()
+{
+    if( state == TFL_DUTY_IDLE)
+    {
+      uint32_t now = millis();
+      if( ( int32_t)( now - due) < 0) return false;   // not due yet
+
+      // Keep to the schedule, or count the samples missed
+      // and restart it if the sketch has fallen behind.
+      due += period;
+      if( ( int32_t)( now - due) >= 0)
+      {
+        stats.misses += ( now - due) / ( period ? period : 1) + 1;
+        due = now + period;
+      }
+
+      // The device makes its own frames: read the newest one
+      if( mode == TFL_DUTY_LOPWR)
+      {
+        if( tfl.getFreshData( dist, flux, temp, tick, addr))
+        {
+          fresh = true;
+          ++stats.samples;
+          return true;
+        }
+        ++stats.misses;
+        return false;
+      }
+
+      // Trigger the device or wake it up
+      wakeAt = micros();
+      bool ok = ( mode == TFL_DUTY_TRIGGER) ?
+                tfl.Set_Trigger( addr) : tfl.Set_Enable( addr);
+      if( ok) state = TFL_DUTY_AWAKE;
+      else ++stats.misses;
+      return false;
+    }
+
+    // - - Awake: wait for a good, new frame - -
+    uint32_t us = micros() - wakeAt;
+    if( mode == TFL_DUTY_TRIGGER && us < convUs) return false;
+
+    if( tfl.getFreshData( dist, flux, temp, tick, addr))
+    {
+      if( mode == TFL_DUTY_SLEEP)
+      {
+        stats.wakeUs = us;
+        if( us > stats.wakeMaxUs) stats.wakeMaxUs = us;
+      }
+      sleep( true);
+      fresh = true;
+      return true;
+    }
+    if( us >= TFL_WAKE_MS * 1000UL) sleep( false);  // give up
+    return false;
+}
+
+// End the awake part of a sample and count the time awake
+void TFLPower::sleep( bool good)
+{
+    if( mode == TFL_DUTY_SLEEP) tfl.Set_Disable( addr);
+    awakeUs += micros() - wakeAt;
+    stats.awakeMs += awakeUs / 1000;
+    awakeUs %= 1000;
+    if( good) ++stats.samples;
+    else ++stats.misses;
+    state = TFL_DUTY_IDLE;
+}
+
+// Pass back the last sample and mark it taken
+bool TFLPower::getData( int16_t &_dist, int16_t &_flux, int16_t &_temp)
+{
+    _dist = dist;
+    _flux = flux;
+    _temp = temp;
+    bool ok = fresh;
+    fresh = false;
+    return ok;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              STATISTICS
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+const TFLPowerStats &TFLPower::getStats()
+{
+    stats.elapsedMs = millis() - startMs;
+    uint32_t ms = stats.elapsedMs ? stats.elapsedMs : 1;
+    stats.rateMilliHz = ( uint64_t)stats.samples * 1000000ULL / ms;
+
+    // mA x ms, then 3600 mA x ms to the microamp-hour
+    uint32_t idleMs = ( stats.elapsedMs > stats.awakeMs) ?
+                      ( stats.elapsedMs - stats.awakeMs) : 0;
+    uint64_t charge = ( uint64_t)activeMa * stats.awakeMs +
+                      ( uint64_t)idleMa * idleMs;
+    stats.chargeUAh = charge / 3600;
+    return stats;
+}
+
+void TFLPower::clearStats()
+{
+    memset( &stats, 0, sizeof( stats));
+    awakeUs = 0;
+    startMs = millis();
+}
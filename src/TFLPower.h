@@ -0,0 +1,118 @@
+/* File Name: TFLPower.h
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Duty-cycled, low power data acquisition for the Benewake
+ *            TF-Luna Lidar sensor configured for the I2C interface.
+ *
+ *  A `TFLPower` object keeps one device idle for most of the time and
+ *  takes one sample every `period` milliseconds, in one of three modes:
+ *    TFL_DUTY_LOPWR   - the device runs in its own low power mode at
+ *                       a frame rate of `FPS_1` to `FPS_10`, and the
+ *                       host reads each new frame on its schedule.
+ *    TFL_DUTY_TRIGGER - the device is in trigger mode and is triggered
+ *                       on the host schedule, then read `convUs` later.
+ *    TFL_DUTY_SLEEP   - the light source is turned OFF between samples
+ *                       with `Set_Disable`.  At each sample it is turned
+ *                       ON with `Set_Enable`, the first good new frame
+ *                       is read, and it is turned OFF again.  The time
+ *                       from `Set_Enable` to that frame is the re-arm
+ *                       latency.
+ *
+ *  `update()` never blocks and must be called often.  It returns true
+ *  when a new sample is ready to be taken with `getData()`.
+ *
+ *  `getStats()` passes back the samples taken, the effective sample
+ *  rate, the re-arm latency and an estimate of the charge used.  The
+ *  estimate counts the time the device is awake at `activeMa` and the
+ *  rest of the time at `idleMa`, as set by `setCurrent()`.  The default
+ *  active current is the average current of the datasheet.  The idle
+ *  current varies with mode and firmware, so measure it and set it.
+ *  In `TFL_DUTY_LOPWR` mode the device is never put to sleep, so all
+ *  of the time is counted at `idleMa`: set it to the low power current.
+ */
+
+#ifndef TFLPOWER_H
+#define TFLPOWER_H
+
+#include <TFLI2C.h>
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//      Definitions
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// Duty cycle modes
+#define TFL_DUTY_LOPWR       0   // device low power mode, FPS_1 to FPS_10
+#define TFL_DUTY_TRIGGER     1   // trigger mode, triggered on the schedule
+#define TFL_DUTY_SLEEP       2   // light source OFF between samples
+
+#define TFL_ACTIVE_MA       70   // datasheet average current, mA
+#define TFL_IDLE_MA          0   // idle current, mA: measure and set
+#define TFL_CONV_US       5000   // trigger to read wait, microseconds
+#define TFL_WAKE_MS        500   // longest wait for a frame after wake
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                 OBJECT CLASS DEFINITIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct TFLPowerStats
+{
+    uint32_t samples;        // good samples taken
+    uint32_t misses;         // samples due but not taken
+    uint32_t elapsedMs;      // time since `begin`
+    uint32_t awakeMs;        // time the device was awake
+    uint32_t wakeUs;         // last re-arm latency, microseconds
+    uint32_t wakeMaxUs;      // longest re-arm latency, microseconds
+    uint32_t rateMilliHz;    // effective sample rate, 0.001 Hz
+    uint32_t chargeUAh;      // estimated charge used, microamp-hours
+};
+
+class TFLPower
+{
+  public:
+    TFLPower( TFLI2C &tfl);
+    ~TFLPower();
+
+    // Put device `addr` into duty cycle `mode` with one sample every
+    // `period` milliseconds.  In `TFL_DUTY_LOPWR` mode `fps` sets the
+    // device frame rate.  Returns false if the device did not answer.
+    bool begin( uint8_t addr, uint8_t mode, uint32_t period,
+                uint16_t fps = FPS_1);
+    // Return the device to normal power, continuous mode and ON
+    bool end();
+
+    // Run the schedule. Returns true when a new sample is ready.
+    bool update();
+    // Take the last sample. Returns false if it is not valid.
+    bool getData( int16_t &dist, int16_t &flux, int16_t &temp);
+
+    // Currents in mA for the charge estimate
+    void setCurrent( uint16_t activeMa, uint16_t idleMa);
+    // Wait from trigger to read in `TFL_DUTY_TRIGGER` mode
+    void setConvTime( uint32_t convUs);
+
+    const TFLPowerStats &getStats();
+    void clearStats();
+
+  private:
+    TFLI2C &tfl;
+    uint8_t  addr;
+    uint8_t  mode;
+    uint8_t  state;          // schedule state
+    uint32_t period;         // milliseconds between samples
+    uint32_t due;            // `millis()` time of the next sample
+    uint32_t wakeAt;         // `micros()` time the device was woken
+    uint32_t startMs;        // `millis()` time of `begin`
+    uint32_t convUs;
+    uint16_t activeMa;
+    uint16_t idleMa;
+    uint16_t tick;           // device tick of the last frame
+    int16_t  dist, flux, temp;
+    bool     fresh;          // sample not yet taken
+    TFLPowerStats stats;
+    uint32_t awakeUs;        // awake time not yet added to `awakeMs`
+
+    void sleep( bool good);
+};
+
+#endif  // TFLPOWER_H
@@ -0,0 +1,193 @@
+/* File Name: TFLProvision.cpp
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Gives each of several Benewake TF-Luna devices on one
+ *            I2C bus an address of its own.
+ *
+ *  A device goes from `TFL_DEF_ADR` to its new address only when
+ *  `Soft_Reset` reboots it with the saved settings.  Until then the
+ *  next enable line must stay off, since two devices would answer at
+ *  `TFL_DEF_ADR`.  A device may still answer for a moment after it
+ *  takes the reset, so the next line is turned on only once nothing
+ *  answers at `TFL_DEF_ADR`.  The rest of the reboot then overlaps the
+ *  power up of the next device.
+ */
+
+#include <TFLProvision.h>
+
+// Steps of the address change, in order
+#define TFL_PROV_ADDR        0
+#define TFL_PROV_SAVE        1
+#define TFL_PROV_RESET       2
+
+// Constructor/Destructor
+TFLProvision::TFLProvision( TFLI2C &_tfl) : tfl( _tfl)
+{
+    enable = NULL;
+    bootMs = TFL_PROV_BOOT_MS;
+    runMs = 0;
+    count = 0;
+    memset( result, TFL_PROV_NONE, sizeof( result));
+}
+TFLProvision::~TFLProvision(){}
+
+void TFLProvision::setEnable( TFLEnableFn fn)
+{
+    enable = fn;
+}
+
+void TFLProvision::setTimeout( uint16_t _bootMs)
+{
+    bootMs = _bootMs;
+}
+
+uint8_t TFLProvision::getResult( uint8_t idx)
+{
+    return ( idx < count) ? result[ idx] : TFL_PROV_NONE;
+}
+
+uint32_t TFLProvision::getRunMs()
+{
+    return runMs;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              PROVISION
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+uint8_t TFLProvision::run( const uint8_t addr[], uint8_t n)
+{
+    uint32_t start = millis();
+    if( n > TFL_PROV_MAX) n = TFL_PROV_MAX;
+    count = n;
+    memset( result, TFL_PROV_NONE, sizeof( result));
+    uint32_t resetMs[ TFL_PROV_MAX];
+    if( !check( addr, n))
+    {
+      runMs = millis() - start;
+      return 0;
+    }
+
+    // Bring up one device at a time and set it on its way
+    for( uint8_t i = 0; i < n; ++i)
+    {
+      if( enable) enable( i, true);
+      uint32_t on = millis();
+      uint8_t again = ( addr[ i] != TFL_DEF_ADR) ? addr[ i] : 0;
+      uint8_t at = await( again, TFL_DEF_ADR, on);
+      if( at == 0)
+      {
+        // It may yet boot at `TFL_DEF_ADR`, next to the next device
+        result[ i] = TFL_PROV_NOBOOT;
+        if( enable) enable( i, false);
+        continue;
+      }
+      if( at == addr[ i])
+      {
+        result[ i] = TFL_PROV_ALREADY;
+        continue;
+      }
+
+      // The last device at `TFL_DEF_ADR` may have left other settings
+      tfl.Clear_Cache( TFL_DEF_ADR);
+      uint32_t t = millis();
+      if( !retry( TFL_PROV_ADDR, addr[ i], t) ||
+          !retry( TFL_PROV_SAVE, 0, t) ||
+          !retry( TFL_PROV_RESET, 0, t))
+      {
+        // Still at `TFL_DEF_ADR`: no other line can be turned on
+        result[ i] = TFL_PROV_WRITE;
+        if( enable) enable( i, false);
+        continue;
+      }
+      resetMs[ i] = millis();
+      if( !leave( resetMs[ i]))
+      {
+        result[ i] = TFL_PROV_WRITE;
+        if( enable) enable( i, false);
+      }
+    }
+
+    // Verify every device that was reset, each from its own reset
+    uint8_t good = 0;
+    for( uint8_t i = 0; i < n; ++i)
+    {
+      if( result[ i] == TFL_PROV_NONE)
+      {
+        uint8_t reg = 0;
+        bool ok = ( await( addr[ i], 0, resetMs[ i]) == addr[ i]) &&
+                  tfl.readRegs( TFL_SET_I2C_ADDR, &reg, 1, addr[ i]) &&
+                  reg == addr[ i];
+        result[ i] = ok ? TFL_PROV_OK : TFL_PROV_VERIFY;
+      }
+      if( result[ i] == TFL_PROV_OK || result[ i] == TFL_PROV_ALREADY) ++good;
+    }
+    tfl.Clear_Cache( TFL_DEF_ADR);
+
+    runMs = millis() - start;
+    return good;
+}
+
+// Give `TFL_PROV_ADDRESS` to every address that is the same as an
+// earlier one, or is `TFL_DEF_ADR` before the last.  Returns false
+// if there was any.
+bool TFLProvision::check( const uint8_t addr[], uint8_t n)
+{
+    bool ok = true;
+    for( uint8_t i = 0; i < n; ++i)
+    {
+      bool bad = ( addr[ i] == TFL_DEF_ADR && i + 1 < n);
+      for( uint8_t k = 0; k < i && !bad; ++k) bad = ( addr[ k] == addr[ i]);
+      if( bad)
+      {
+        result[ i] = TFL_PROV_ADDRESS;
+        ok = false;
+      }
+    }
+    return ok;
+}
+
+// Wait until a device answers at address `a` or `b`, 0 for none,
+// until `bootMs` after `start`.  Returns the address, or 0.
+uint8_t TFLProvision::await( uint8_t a, uint8_t b, uint32_t start)
+{
+    while( true)
+    {
+      if( a && tfl.probe( a)) return a;
+      if( b && tfl.probe( b)) return b;
+      if( millis() - start >= bootMs) return 0;
+      delayMicroseconds( TFL_PROV_POLL_US);
+    }
+}
+
+// Wait until nothing answers at `TFL_DEF_ADR`, until `bootMs`
+// after `start`.  Returns false if a device still answers.
+bool TFLProvision::leave( uint32_t start)
+{
+    while( tfl.probe( TFL_DEF_ADR))
+    {
+      if( millis() - start >= bootMs) return false;
+      delayMicroseconds( TFL_PROV_POLL_US);
+    }
+    return true;
+}
+
+// Send one step to `TFL_DEF_ADR` until the device takes it, for up
+// to `bootMs` after `start`.  The device may not answer while it
+// writes its flash after a save.
+bool TFLProvision::retry( uint8_t step, uint8_t arg, uint32_t start)
+{
+    while( true)
+    {
+      bool ok = false;
+      switch( step)
+      {
+        case TFL_PROV_ADDR:  ok = tfl.Set_I2C_Addr( arg, TFL_DEF_ADR); break;
+        case TFL_PROV_SAVE:  ok = tfl.Save_Settings( TFL_DEF_ADR);    break;
+        case TFL_PROV_RESET: ok = tfl.Soft_Reset( TFL_DEF_ADR);       break;
+      }
+      if( ok) return true;
+      if( millis() - start >= bootMs) return false;
+      delayMicroseconds( TFL_PROV_POLL_US);
+    }
+}
@@ -0,0 +1,106 @@
+/* File Name: TFLProvision.h
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Gives each of several Benewake TF-Luna devices on one
+ *            I2C bus an address of its own.
+ *
+ *  Every device leaves the factory at address `TFL_DEF_ADR`, so the
+ *  devices of a rig are brought onto the bus one at a time.  Each one
+ *  is held off by an enable line, a power switch for example, that a
+ *  sketch function turns on and off.  `run()` then, for each device:
+ *    - turns its line on and waits until it answers at `TFL_DEF_ADR`,
+ *    - writes its new address, saves the settings and resets it,
+ *    - waits until it stops answering at `TFL_DEF_ADR`,
+ *    - and goes on to the next device without waiting for the reboot.
+ *  The reboot of each device thus overlaps the power up of the next.
+ *  Each write is retried until the device takes it, rather than after
+ *  a fixed delay.  When all devices are reset, `run()` waits for each
+ *  at its new address and reads the address register back from it.
+ *
+ *  A device that answers at its new address when its line is turned on
+ *  already has it and is left alone, so `run()` can be repeated on a
+ *  rig that is partly provisioned.  The lines are left on, but for
+ *  devices that did not boot or did not take their address.
+ *
+ *  The addresses must all differ, and only the last may be
+ *  `TFL_DEF_ADR`, as a device left there would answer together with
+ *  the next one.  Otherwise `run()` turns on no line, gives the
+ *  entries at fault `TFL_PROV_ADDRESS` and returns 0.
+ *
+ *  Typical use:
+ *    const uint8_t pins[] = { 2, 3, 4, 5};
+ *    void enable( uint8_t idx, bool on) { digitalWrite( pins[ idx], on);}
+ *    ...
+ *    TFLI2C tflI2C;
+ *    TFLProvision tflProv( tflI2C);
+ *    const uint8_t addrs[] = { 0x11, 0x12, 0x13, 0x14};
+ *    tflProv.setEnable( enable);
+ *    uint8_t good = tflProv.run( addrs, 4);
+ *    for( uint8_t i = 0; i < 4; ++i) tflProv.getResult( i) ...
+ */
+
+#ifndef TFLPROVISION_H
+#define TFLPROVISION_H
+
+#include <TFLI2C.h>
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//      Definitions
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#define TFL_PROV_MAX        16   // devices in one run
+#define TFL_PROV_BOOT_MS  1000   // longest wait for a device to answer
+#define TFL_PROV_POLL_US  1000   // wait between two tries
+
+// Result of one device
+#define TFL_PROV_NONE        0   // not provisioned yet
+#define TFL_PROV_OK          1   // answers at its new address
+#define TFL_PROV_ALREADY     2   // had its new address already
+#define TFL_PROV_NOBOOT      3   // never answered at `TFL_DEF_ADR`
+#define TFL_PROV_WRITE       4   // did not take the address, save or reset
+#define TFL_PROV_VERIFY      5   // not found at its new address
+#define TFL_PROV_ADDRESS     6   // same address as an earlier device, or
+                                 // `TFL_DEF_ADR` before the last device
+
+// Turns the enable line of device `idx` on or off
+typedef void ( *TFLEnableFn)( uint8_t idx, bool on);
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                 OBJECT CLASS DEFINITIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+class TFLProvision
+{
+  public:
+    TFLProvision( TFLI2C &tfl);
+    ~TFLProvision();
+
+    // Function that turns the enable lines on and off
+    void setEnable( TFLEnableFn fn);
+    // Longest wait for a device to answer after power up or reset
+    void setTimeout( uint16_t bootMs);
+
+    // Give device `i` the address `addr[i]`, for `n` devices whose
+    // enable lines are off.  Returns the number that answer at their
+    // new address.
+    uint8_t run( const uint8_t addr[], uint8_t n);
+
+    uint8_t  getResult( uint8_t idx);   // `TFL_PROV_*` result of a device
+    uint32_t getRunMs();                // time of the last run
+
+  private:
+    TFLI2C &tfl;
+    TFLEnableFn enable;
+    uint16_t bootMs;
+    uint32_t runMs;
+    uint8_t  count;
+    uint8_t  result[ TFL_PROV_MAX];
+
+    uint8_t  await( uint8_t a, uint8_t b, uint32_t start);
+    bool     retry( uint8_t step, uint8_t arg, uint32_t start);
+    bool     leave( uint32_t start);
+    bool     check( const uint8_t addr[], uint8_t n);
+};
+
+#endif  // TFLPROVISION_H
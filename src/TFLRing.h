@@ -0,0 +1,162 @@
+/* File Name: TFLRing.h
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Fixed capacity, lock-free ring buffer of TF-Luna data
+ *            frames for one producer and one consumer.
+ *
+ *  The producer, such as a FreeRTOS task or the completion callback of
+ *  an asynchronous read, calls `push()`.  The consumer, usually the
+ *  main loop, calls `pop()` or `popBatch()` to drain frames in batches.
+ *  Neither side ever blocks or disables interrupts.
+ *
+ *  The capacity `N` is a template parameter and must be a power of
+ *  two, so that no memory is allocated and an AVR sketch pays only for
+ *  the frames it asks for.  On 8-bit AVR the indices are single bytes,
+ *  which are read and written atomically, so `N` is limited to 128.
+ *
+ *  When the buffer is full, `push()` drops the new frame and counts an
+ *  overrun. `getOverruns()` and the high-water mark `getPeak()` help to
+ *  choose a capacity for a given frame rate and consumer latency.  Both
+ *  are kept in the index type, so the consumer reads them atomically
+ *  too, and the overrun count stops at `TFL_RING_COUNT_MAX`: 255 on AVR.
+ *
+ *  Example:
+ *    TFLRing< 64> ring;                 // 64 frames
+ *    ring.push( frame);                 // producer
+ *    TFLFrame batch[ 16];
+ *    uint16_t n = ring.popBatch( batch, 16);   // consumer
+ */
+
+#ifndef TFLRING_H
+#define TFLRING_H
+
+#include <TFLI2C.h>
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//      Definitions
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#if defined( __AVR__)
+  typedef uint8_t tflRingIndex;   // single byte is atomic on AVR
+  #define TFL_RING_MAX       128
+  #define TFL_RING_COUNT_MAX 0xFF
+  // Compiler barrier only: AVR is single core
+  #define TFL_RING_FENCE()   __asm__ __volatile__( "" ::: "memory")
+#else
+  typedef uint16_t tflRingIndex;
+  #define TFL_RING_MAX     32768
+  #define TFL_RING_COUNT_MAX 0xFFFF
+  // Full barrier: the producer may run on the other core
+  #define TFL_RING_FENCE()   __sync_synchronize()
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                 OBJECT CLASS DEFINITIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template< uint16_t N, typename T = TFLFrame>
+class TFLRing
+{
+    static_assert( N >= 2 && ( N & ( N - 1)) == 0,
+                   "TFLRing capacity must be a power of two");
+    static_assert( N <= TFL_RING_MAX,
+                   "TFLRing capacity too large for this platform");
+
+  public:
+    typedef T Item;                     // type of the items kept
+
+    TFLRing() : head( 0), tail( 0), peak( 0), overruns( 0) {}
+
+    // - - - -   Producer side   - - - -
+    // Copy `item` into the buffer.
+    // Returns false and counts an overrun if the buffer is full.
+    bool push( const T &item)
+    {
+        tflRingIndex h = head;
+        tflRingIndex used = ( tflRingIndex)( h - tail);
+        if( used >= N)
+        {
+          if( overruns < TFL_RING_COUNT_MAX) ++overruns;
+          return false;
+        }
+        buf[ h & ( N - 1)] = item;
+        TFL_RING_FENCE();              // item is stored before...
+        head = ( tflRingIndex)( h + 1);  // ...it is published
+        if( used + 1 > peak) peak = used + 1;
+        return true;
+    }
+
+    // - - - -   Consumer side   - - - -
+    // Copy the oldest frame into `item` and remove it.
+    // Returns false if the buffer is empty.
+    bool pop( T &item)
+    {
+        tflRingIndex t = tail;
+        if( t == head) return false;
+        TFL_RING_FENCE();              // head is read before the item
+        item = buf[ t & ( N - 1)];
+        TFL_RING_FENCE();              // item is copied before...
+        tail = ( tflRingIndex)( t + 1);  // ...its slot is released
+        return true;
+    }
+
+    // Copy up to `max` of the oldest frames into `out` and remove them.
+    // Returns the number of frames copied.
+    uint16_t popBatch( T out[], uint16_t max)
+    {
+        tflRingIndex t = tail;
+        tflRingIndex n = ( tflRingIndex)( head - t);
+        if( n > max) n = max;
+        TFL_RING_FENCE();
+        for( tflRingIndex i = 0; i < n; ++i)
+        {
+          out[ i] = buf[ ( tflRingIndex)( t + i) & ( N - 1)];
+        }
+        TFL_RING_FENCE();
+        tail = ( tflRingIndex)( t + n);
+        return n;
+    }
+
+    // Point to the oldest frame without removing it, or NULL if empty.
+    // The frame stays valid until `discard()` is called.
+    const T *peek() const
+    {
+        tflRingIndex t = tail;
+        if( t == head) return NULL;
+        TFL_RING_FENCE();
+        return &buf[ t & ( N - 1)];
+    }
+
+    // Remove the oldest frame, normally after `peek()`
+    void discard()
+    {
+        tflRingIndex t = tail;
+        if( t == head) return;
+        TFL_RING_FENCE();
+        tail = ( tflRingIndex)( t + 1);
+    }
+
+    // - - - -   Either side   - - - -
+    uint16_t count() const    { return ( tflRingIndex)( head - tail);}
+    uint16_t capacity() const { return N;}
+    bool isEmpty() const      { return( head == tail);}
+    bool isFull() const       { return( count() >= N);}
+
+    // Frames dropped because the buffer was full,
+    // up to `TFL_RING_COUNT_MAX`
+    uint32_t getOverruns() const { return overruns;}
+    // Largest number of frames ever waiting in the buffer
+    uint16_t getPeak() const     { return peak;}
+    // Clear the overrun count and the peak. Call from the producer side.
+    void clearStats()            { overruns = 0; peak = 0;}
+
+  private:
+    T buf[ N];
+    volatile tflRingIndex head;     // written only by the producer
+    volatile tflRingIndex tail;     // written only by the consumer
+    volatile tflRingIndex peak;     //    "     "    "     producer
+    volatile tflRingIndex overruns; //    "     "    "     producer
+};
+
+#endif  // TFLRING_H
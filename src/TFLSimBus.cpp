@@ -0,0 +1,320 @@
+/* File Name: TFLSimBus.cpp
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Simulated TF-Luna devices on a mock transport.
+ *
+ *  Frames are made when they are read: a read works out how many
+ *  frame periods have passed since the last frame and makes the latest
+ *  one, stamped with the device time it was due.  Frames that were
+ *  never read are lost, as on the device.
+ *
+ *  Bus time is counted as nine clocks for every byte, with the address
+ *  byte, plus two for the START and STOP.
+ */
+
+#include <TFLSimBus.h>
+
+// Constructor
+TFLSimBus::TFLSimBus()
+{
+    realTime = false;
+    bootTime = TFL_SIM_BOOT_US;
+    trigTime = TFL_SIM_TRIG_US;
+    errRate = 0;
+    errStatus = TFL_I2CREAD;
+    seed = 1;
+    reset();
+}
+
+void TFLSimBus::reset()
+{
+    TFLMockBus::reset();
+    memset( sim, 0, sizeof( sim));
+    timeUs = 0;
+    frames = 0;
+    busUs = 0;
+    errors = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              DEVICES
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TFLSimBus::add( uint8_t addr)
+{
+    if( addr == 0 || device( addr) || regs( addr)) return false;
+    SimDevice *d = device( 0);
+    if( !d || !attach( addr)) return false;
+    factory( *d, addr);
+    d->addr = addr;
+    d->serial = addr;
+    d->dist = 100;
+    d->flux = 1000;
+    d->temp = 2500;
+    reboot( *d, 0);
+    return true;
+}
+
+bool TFLSimBus::powerCycle( uint8_t addr)
+{
+    SimDevice *d = device( addr);
+    if( !d) return false;
+    reboot( *d, bootTime);
+    return true;
+}
+
+bool TFLSimBus::setTarget( uint8_t addr, int16_t dist, int16_t flux,
+                           int16_t temp, uint16_t noise)
+{
+    SimDevice *d = device( addr);
+    if( !d) return false;
+    d->dist = dist;
+    d->flux = flux;
+    d->temp = temp;
+    d->noise = noise;
+    return true;
+}
+
+bool TFLSimBus::setDevError( uint8_t addr, uint16_t err)
+{
+    SimDevice *d = device( addr);
+    if( !d) return false;
+    d->err = err;
+    return true;
+}
+
+void TFLSimBus::setErrorRate( uint16_t perMille, uint8_t status)
+{
+    errRate = perMille;
+    errStatus = status;
+}
+
+void TFLSimBus::setTiming( uint32_t bootUs, uint32_t trigUs)
+{
+    bootTime = bootUs;
+    trigTime = trigUs;
+}
+
+void TFLSimBus::setSeed( uint32_t _seed)
+{
+    seed = _seed ? _seed : 1;
+}
+
+TFLSimBus::SimDevice *TFLSimBus::device( uint8_t addr)
+{
+    for( uint8_t i = 0; i < TFL_MOCK_DEVICES; ++i)
+    {
+      if( sim[ i].addr == addr) return &sim[ i];
+    }
+    return NULL;
+}
+
+// Save the factory configuration, at address `addr`
+void TFLSimBus::factory( SimDevice &d, uint8_t addr)
+{
+    memset( d.saved, 0, sizeof( d.saved));
+    d.saved[ TFL_SET_I2C_ADDR - TFL_SHADOW_FIRST] = addr;
+    d.saved[ TFL_SET_TRIG_MODE - TFL_SHADOW_FIRST] = 0;    // continuous
+    d.saved[ TFL_DISABLE - TFL_SHADOW_FIRST] = 1;          // enabled
+    d.saved[ TFL_FPS_LO - TFL_SHADOW_FIRST] = TFL_DEF_FPS;
+    d.saved[ TFL_FPS_HI - TFL_SHADOW_FIRST] = 0;
+    d.saved[ TFL_SET_LO_PWR - TFL_SHADOW_FIRST] = 0;
+}
+
+// Start the device again from its saved configuration.
+// It does not acknowledge for `blackUs` microseconds.
+void TFLSimBus::reboot( SimDevice &d, uint32_t blackUs)
+{
+    uint8_t want = d.saved[ TFL_SET_I2C_ADDR - TFL_SHADOW_FIRST];
+    if( want != d.addr && device( want) == NULL && move( d.addr, want))
+    {
+      d.addr = want;
+    }
+
+    uint8_t *r = regs( d.addr);
+    memset( r, 0, TFL_MOCK_REGS);
+    r[ TFL_VER_REV] = TFL_SIM_VER_REV;
+    r[ TFL_VER_MIN] = TFL_SIM_VER_MIN;
+    r[ TFL_VER_MAJ] = TFL_SIM_VER_MAJ;
+    memcpy( r + TFL_PROD_CODE, "SIMTFLUNA00", TFL_PROD_LEN - 3);
+    r[ TFL_PROD_CODE + 11] = '0' + d.serial / 100;
+    r[ TFL_PROD_CODE + 12] = '0' + d.serial / 10 % 10;
+    r[ TFL_PROD_CODE + 13] = '0' + d.serial % 10;
+    memcpy( r + TFL_SHADOW_FIRST, d.saved, TFL_SHADOW_LEN);
+    r[ TFL_SET_I2C_ADDR] = d.addr;
+
+    d.trig = false;
+    d.err = 0;
+    d.bootUs = now() + blackUs;
+    schedule( d, d.bootUs);
+}
+
+// Next frame one frame period after `from`
+void TFLSimBus::schedule( SimDevice &d, uint32_t from)
+{
+    const uint8_t *r = regs( d.addr);
+    uint16_t fps = r[ TFL_FPS_LO] + ( r[ TFL_FPS_HI] << 8);
+    d.nextUs = from + ( fps ? 1000000UL / fps : 0);
+}
+
+void TFLSimBus::makeFrame( SimDevice &d, uint32_t at)
+{
+    int16_t dist = d.dist;
+    if( d.noise) dist += ( int16_t)( nextRandom() % ( 2UL * d.noise + 1)) - d.noise;
+    uint16_t tick = ( uint16_t)( ( at - d.bootUs) / 1000);
+
+    uint8_t *r = regs( d.addr);
+    r[ TFL_DIST_LO] = ( uint8_t)dist;
+    r[ TFL_DIST_HI] = ( uint8_t)( dist >> 8);
+    r[ TFL_FLUX_LO] = ( uint8_t)d.flux;
+    r[ TFL_FLUX_HI] = ( uint8_t)( d.flux >> 8);
+    r[ TFL_TEMP_LO] = ( uint8_t)d.temp;
+    r[ TFL_TEMP_HI] = ( uint8_t)( d.temp >> 8);
+    r[ TFL_TICK_LO] = ( uint8_t)tick;
+    r[ TFL_TICK_HI] = ( uint8_t)( tick >> 8);
+    r[ TFL_ERR_LO] = ( uint8_t)d.err;
+    r[ TFL_ERR_HI] = ( uint8_t)( d.err >> 8);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              DEVICE MODEL
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Make the frame due at this time, if there is one
+void TFLSimBus::reading( uint8_t addr)
+{
+    SimDevice *d = device( addr);
+    if( !d) return;
+    const uint8_t *r = regs( addr);
+    uint32_t t = now();
+
+    if( r[ TFL_SET_TRIG_MODE])
+    {
+      if( d->trig && ( int32_t)( t - d->trigUs) >= 0)
+      {
+        makeFrame( *d, d->trigUs);
+        d->trig = false;
+        ++frames;
+      }
+      return;
+    }
+
+    uint16_t fps = r[ TFL_FPS_LO] + ( r[ TFL_FPS_HI] << 8);
+    if( !r[ TFL_DISABLE] || fps == 0 || ( int32_t)( t - d->nextUs) < 0) return;
+    uint32_t period = 1000000UL / fps;
+    uint32_t late = ( t - d->nextUs) / period;   // frames missed
+    uint32_t at = d->nextUs + late * period;
+    makeFrame( *d, at);
+    d->nextUs = at + period;
+    frames += late + 1;
+}
+
+// Act on the command registers
+void TFLSimBus::written( uint8_t addr, uint8_t reg, uint8_t value)
+{
+    SimDevice *d = device( addr);
+    if( !d) return;
+    uint8_t *r = regs( addr);
+
+    switch( reg)
+    {
+      case TFL_SAVE_SETTINGS:
+        r[ reg] = 0;
+        if( value == 1) memcpy( d->saved, r + TFL_SHADOW_FIRST, TFL_SHADOW_LEN);
+        break;
+      case TFL_SOFT_RESET:
+        r[ reg] = 0;
+        if( value == 2) reboot( *d, bootTime);
+        break;
+      case TFL_HARD_RESET:
+        r[ reg] = 0;
+        if( value == 1)
+        {
+          factory( *d, TFL_DEF_ADR);
+          reboot( *d, bootTime);
+        }
+        break;
+      case TFL_TRIGGER:
+        r[ reg] = 0;
+        if( value == 1 && r[ TFL_SET_TRIG_MODE])
+        {
+          d->trig = true;
+          d->trigUs = now() + trigTime;
+        }
+        break;
+      case TFL_SET_TRIG_MODE:
+      case TFL_DISABLE:
+      case TFL_FPS_LO:
+      case TFL_FPS_HI:
+        schedule( *d, now());
+        break;
+    }
+}
+
+// Status of a transaction with the device at `addr`: no acknowledge
+// while it boots, or an injected error
+uint8_t TFLSimBus::fault( uint8_t addr, uint8_t fail)
+{
+    SimDevice *d = device( addr);
+    if( d && ( int32_t)( now() - d->bootUs) < 0) return fail;
+    if( errRate && nextRandom() % 1000 < errRate)
+    {
+      ++errors;
+      return errStatus;
+    }
+    return TFL_READY;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              TRANSACTIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+uint8_t TFLSimBus::writeRegs( uint8_t addr, uint8_t reg, const uint8_t *buf, uint8_t len)
+{
+    uint8_t status = fault( addr, TFL_I2CWRITE);
+    if( status == TFL_READY) status = TFLMockBus::writeRegs( addr, reg, buf, len);
+    transfer( ( status == TFL_READY) ? 2 + len : 1);
+    return status;
+}
+
+uint8_t TFLSimBus::receive( uint8_t addr, uint8_t *buf, uint8_t len)
+{
+    uint8_t status = fault( addr, TFL_I2CREAD);
+    if( status == TFL_READY) status = TFLMockBus::receive( addr, buf, len);
+    transfer( ( status == TFL_READY) ? 1 + len : 1);
+    return status;
+}
+
+// Count the bus time of `bytes` bytes
+void TFLSimBus::transfer( uint8_t bytes)
+{
+    uint32_t hz = clock ? clock : TFL_SIM_CLOCK;
+    uint32_t us = ( ( uint32_t)bytes * 9 + 2) * 1000000UL / hz;
+    busUs += us;
+    if( !realTime) timeUs += us;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              TIME
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TFLSimBus::advance( uint32_t us)
+{
+    timeUs += us;
+}
+
+void TFLSimBus::useMicros( bool on)
+{
+    realTime = on;
+}
+
+uint32_t TFLSimBus::now()
+{
+    return realTime ? micros() : timeUs;
+}
+
+// xorshift generator for noise and injected errors
+uint32_t TFLSimBus::nextRandom()
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
@@ -0,0 +1,148 @@
+/* File Name: TFLSimBus.h
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Simulated TF-Luna devices on a mock transport, for tests
+ *            and benchmarks of the TFLI2C library without a sensor.
+ *
+ *  A `TFLSimBus` is a `TFLMockBus` whose devices behave like a TF-Luna:
+ *    - The whole register map, 0x00 to 0x29, is filled at power up:
+ *      firmware version, a production code at `TFL_PROD_CODE` and the
+ *      factory configuration.
+ *    - In continuous mode an enabled device makes a new frame at the
+ *      rate in `TFL_FPS_LO/HI`.  The tick is the device time of the
+ *      frame in milliseconds.  A disabled device makes no frames.
+ *    - In trigger mode a write to `TFL_TRIGGER` makes one frame after
+ *      the trigger latency.
+ *    - `TFL_SAVE_SETTINGS` keeps the configuration.  `TFL_SOFT_RESET`
+ *      reboots with the kept configuration, at a new address if one
+ *      was saved, and `TFL_HARD_RESET` with the factory configuration.
+ *      A rebooting device does not acknowledge for the boot time.
+ *    - Bus errors can be injected at random with `setErrorRate`, as
+ *      well as with `failNext`.  `setDevError` sets the error register
+ *      of a device until it reboots.
+ *
+ *  Time is virtual: it stands still until `advance` is called, and
+ *  moves on with the bus time of every transaction at the clock set by
+ *  `setClock`.  Runs are then the same on every host and at any speed.
+ *  `useMicros( true)` runs the devices on `micros()` instead, for code
+ *  that keeps its own time, such as the `TFLI2CArray` schedule.
+ *
+ *  Typical use:
+ *    TFLSimBus sim;
+ *    TFLI2C tflI2C;
+ *    ...
+ *    sim.add( 0x10);
+ *    sim.setTarget( 0x10, 150, 800);       // 150cm, flux 800
+ *    tflI2C.Set_Bus( &sim);
+ *    sim.advance( 10000);                  // 10ms later
+ *
+ *  The benchmark in "extras/TFLSimBench" runs the read paths of the
+ *  library against a `TFLSimBus` on a host.
+ */
+
+#ifndef TFLSIMBUS_H
+#define TFLSIMBUS_H
+
+#include <TFLMockBus.h>
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//      Definitions
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#define TFL_SIM_BOOT_US    100000UL   // no acknowledge after a reboot
+#define TFL_SIM_TRIG_US      3000UL   // trigger to frame latency
+#define TFL_SIM_CLOCK      100000UL   // bus clock until `setClock`
+#define TFL_SIM_VER_MAJ         3     // firmware version reported
+#define TFL_SIM_VER_MIN         2
+#define TFL_SIM_VER_REV         0
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                 OBJECT CLASS DEFINITIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+class TFLSimBus : public TFLMockBus
+{
+  public:
+    TFLSimBus();
+
+    // Remove all devices, clear the counters and set time to zero
+    void reset();
+
+    // Add a device at `addr`, powered up with the factory configuration
+    // saved at that address.  Returns false if the bus is full.
+    bool add( uint8_t addr = TFL_DEF_ADR);
+    // Power the device at `addr` off and on again
+    bool powerCycle( uint8_t addr);
+
+    // Target the device at `addr` will measure, with `noise`
+    // centimeters of random error on each frame
+    bool setTarget( uint8_t addr, int16_t dist, int16_t flux,
+                    int16_t temp = 2500, uint16_t noise = 0);
+    // Error register of the frames of the device at `addr`, until it reboots
+    bool setDevError( uint8_t addr, uint16_t err);
+    // Fail about `perMille` of every 1000 transactions with `status`
+    void setErrorRate( uint16_t perMille, uint8_t status = TFL_I2CREAD);
+    // Boot time and trigger latency in microseconds
+    void setTiming( uint32_t bootUs, uint32_t trigUs);
+    // Seed of the noise and error generator
+    void setSeed( uint32_t seed);
+
+    // Move virtual time on by `us` microseconds
+    void advance( uint32_t us);
+    // Run on `micros()` instead of virtual time
+    void useMicros( bool on);
+    // Device time now, in microseconds
+    uint32_t now();
+
+    uint32_t frames;         // frames made by all devices, read or not
+    uint32_t busUs;          // bus time of all transactions
+    uint32_t errors;         // errors injected by `setErrorRate`
+
+    // - - -   TFLBus   - - -
+    // `readRegs` of the mock calls these two, so a read costs the
+    // bus time of a pointer write and of a receive.
+    uint8_t writeRegs( uint8_t addr, uint8_t reg, const uint8_t *buf, uint8_t len);
+    uint8_t receive( uint8_t addr, uint8_t *buf, uint8_t len);
+
+  protected:
+    void reading( uint8_t addr);
+    void written( uint8_t addr, uint8_t reg, uint8_t value);
+
+  private:
+    struct SimDevice
+    {
+        uint8_t  addr;       // I2C address, 0 = slot unused
+        uint8_t  serial;     // end of the production code: the address
+                             // the device was added at
+        uint32_t bootUs;     // time the device came up
+        uint32_t nextUs;     // time the next frame is due
+        uint32_t trigUs;     // time the triggered frame is due
+        bool     trig;       // triggered frame pending
+        int16_t  dist;       // target
+        int16_t  flux;
+        int16_t  temp;
+        uint16_t noise;
+        uint16_t err;        // error register
+        uint8_t  saved[ TFL_SHADOW_LEN];   // kept configuration
+    };
+    SimDevice sim[ TFL_MOCK_DEVICES];
+    uint32_t timeUs;         // virtual time
+    bool     realTime;
+    uint32_t bootTime;
+    uint32_t trigTime;
+    uint16_t errRate;
+    uint8_t  errStatus;
+    uint32_t seed;
+
+    SimDevice *device( uint8_t addr);
+    void factory( SimDevice &d, uint8_t addr);
+    void reboot( SimDevice &d, uint32_t blackUs);
+    void schedule( SimDevice &d, uint32_t from);
+    void makeFrame( SimDevice &d, uint32_t at);
+    uint8_t fault( uint8_t addr, uint8_t fail);
+    void transfer( uint8_t bytes);
+    uint32_t nextRandom();
+};
+
+#endif  // TFLSIMBUS_H
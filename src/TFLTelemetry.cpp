@@ -0,0 +1,292 @@
+/* File Name: TFLTelemetry.cpp
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Compact binary packets of TF-Luna frames, to stream
+ *            every frame of several devices over a serial link.
+ *
+ *  The encoder and the decoder run the same model of each device: the
+ *  distance and tick of its last packet.  A change is sent against
+ *  that model, so both ends must see the same packets.  The decoder
+ *  cannot tell which device a bad packet was for, so after one it
+ *  waits for a key packet from every device.
+ */
+
+#include <TFLTelemetry.h>
+
+static void put16( uint8_t *p, uint16_t v)
+{
+    p[ 0] = ( uint8_t)v;
+    p[ 1] = ( uint8_t)( v >> 8);
+}
+
+static uint16_t get16( const uint8_t *p)
+{
+    return ( uint16_t)p[ 0] | ( ( uint16_t)p[ 1] << 8);
+}
+
+// Bytes of flux and temperature for `fields`
+static uint8_t fieldBytes( uint8_t fields)
+{
+    return ( ( fields & TFL_TLM_FLUX) ? 2 : 0) + ( ( fields & TFL_TLM_TEMP) ? 2 : 0);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              ENCODER
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+TFLTelemetry::TFLTelemetry( uint8_t _fields)
+{
+    fields = _fields & ( TFL_TLM_FLUX | TFL_TLM_TEMP);
+    base = TFL_DEF_ADR;
+    keyEvery = TFL_TLM_KEY;
+    frames = 0;
+    bytes = 0;
+    reset();
+}
+
+void TFLTelemetry::setFields( uint8_t _fields)
+{
+    fields = _fields & ( TFL_TLM_FLUX | TFL_TLM_TEMP);
+}
+
+void TFLTelemetry::setBase( uint8_t addr)
+{
+    base = addr;
+}
+
+void TFLTelemetry::setKeyEvery( uint8_t n)
+{
+    keyEvery = n ? n : 1;
+}
+
+void TFLTelemetry::reset()
+{
+    memset( dev, 0, sizeof( dev));
+}
+
+uint8_t TFLTelemetry::encode( const TFLFrame &f, uint8_t out[])
+{
+    uint8_t len = pack( f, out, dev[ idOf( f.addr)]);
+    ++frames;
+    bytes += len;
+    return len;
+}
+
+// Pack `f` against the model `d` of its device, and move the model on
+uint8_t TFLTelemetry::pack( const TFLFrame &f, uint8_t out[], Device &d)
+{
+    uint8_t n = 0;
+    out[ n++] = TFL_TLM_SYNC | fields;
+    uint8_t status = ( uint8_t)f.status;
+    if( status < TFL_TLM_STAT_ESC) out[ n++] = idOf( f.addr) | ( status << 4);
+    else
+    {
+      out[ n++] = idOf( f.addr) | ( TFL_TLM_STAT_ESC << 4);
+      out[ n++] = status;
+    }
+
+    bool key = ( d.left == 0);
+    int32_t dd = ( int32_t)f.dist - d.dist;
+    if( key || dd < -127 || dd > 127)
+    {
+      out[ n++] = TFL_TLM_DIST_ESC;
+      put16( out + n, f.dist);
+      n += 2;
+    }
+    else out[ n++] = ( uint8_t)( int8_t)dd;
+
+    uint16_t dt = f.tick - d.tick;
+    if( key || dt >= TFL_TLM_TICK_ESC)
+    {
+      out[ n++] = TFL_TLM_TICK_ESC;
+      put16( out + n, f.tick);
+      n += 2;
+    }
+    else out[ n++] = ( uint8_t)dt;
+
+    if( fields & TFL_TLM_FLUX)
+    {
+      put16( out + n, f.flux);
+      n += 2;
+    }
+    if( fields & TFL_TLM_TEMP)
+    {
+      put16( out + n, f.temp);
+      n += 2;
+    }
+    out[ n] = tflCrc8( out + 1, n - 1);
+    ++n;
+
+    d.dist = f.dist;
+    d.tick = f.tick;
+    d.left = key ? keyEvery - 1 : d.left - 1;
+    return n;
+}
+
+uint32_t TFLTelemetry::getFrames()
+{
+    return frames;
+}
+
+uint32_t TFLTelemetry::getBytes()
+{
+    return bytes;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+//              DECODER
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+TFLTelemetryDecoder::TFLTelemetryDecoder()
+{
+    base = TFL_DEF_ADR;
+    errors = 0;
+    dropped = 0;
+    memset( &out, 0, sizeof( out));
+    last = 0;
+    reset();
+}
+
+void TFLTelemetryDecoder::setBase( uint8_t addr)
+{
+    base = addr;
+}
+
+void TFLTelemetryDecoder::reset()
+{
+    memset( dev, 0, sizeof( dev));
+    len = 0;
+    skipping = false;
+}
+
+const TFLFrame &TFLTelemetryDecoder::frame()
+{
+    return out;
+}
+
+uint8_t TFLTelemetryDecoder::id()
+{
+    return last;
+}
+
+uint32_t TFLTelemetryDecoder::getErrors()
+{
+    return errors;
+}
+
+uint32_t TFLTelemetryDecoder::getDropped()
+{
+    return dropped;
+}
+
+bool TFLTelemetryDecoder::put( uint8_t b)
+{
+    if( len == 0 && ( b & 0xFC) != TFL_TLM_SYNC)
+    {
+      // A byte between packets: a packet may have been lost
+      if( !skipping) lost();
+      skipping = true;
+      return false;
+    }
+    skipping = false;
+    buf[ len++] = b;
+
+    while( len > 0 && len >= expected())
+    {
+      if( buf[ len - 1] == tflCrc8( buf + 1, len - 2))
+      {
+        bool good = unpack();
+        len = 0;
+        return good;
+      }
+
+      // A bad packet.  Look for the next sync byte
+      // among the bytes already taken.
+      lost();
+      uint8_t i = 1;
+      while( i < len && ( buf[ i] & 0xFC) != TFL_TLM_SYNC) ++i;
+      len -= i;
+      memmove( buf, buf + i, len);
+    }
+    return false;
+}
+
+// Every model is in doubt, as the decoder cannot tell
+// which device the lost packet was for
+void TFLTelemetryDecoder::lost()
+{
+    ++errors;
+    for( uint8_t i = 0; i < TFL_TLM_IDS; ++i) dev[ i].synced = false;
+}
+
+// Length of the packet in `buf`, as far as the bytes so far tell
+uint8_t TFLTelemetryDecoder::expected()
+{
+    uint8_t need = 2;                          // sync, head
+    if( len > 1 && ( buf[ 1] >> 4) == TFL_TLM_STAT_ESC) ++need;
+    uint8_t d = need++;                        // dist
+    if( len > d && buf[ d] == TFL_TLM_DIST_ESC) need += 2;
+    uint8_t at = need;                         // tick
+    ++need;
+    if( len > at && buf[ at] == TFL_TLM_TICK_ESC) need += 2;
+    return need + fieldBytes( buf[ 0] & 0x03) + 1;
+}
+
+// Apply a good packet to the model of its device.  Returns false if
+// the device is waiting for a key packet.
+bool TFLTelemetryDecoder::unpack()
+{
+    uint8_t id = buf[ 1] & 0x0F;
+    Device &d = dev[ id];
+    uint8_t p = 2;
+    uint8_t status = buf[ 1] >> 4;
+    if( status == TFL_TLM_STAT_ESC) status = buf[ p++];
+    bool full = true;
+
+    int16_t dist;
+    if( buf[ p] == TFL_TLM_DIST_ESC)
+    {
+      dist = ( int16_t)get16( buf + p + 1);
+      p += 3;
+    }
+    else
+    {
+      dist = d.dist + ( int8_t)buf[ p++];
+      full = false;
+    }
+
+    uint16_t tick;
+    if( buf[ p] == TFL_TLM_TICK_ESC)
+    {
+      tick = get16( buf + p + 1);
+      p += 3;
+    }
+    else
+    {
+      tick = d.tick + buf[ p++];
+      full = false;
+    }
+
+    if( !d.synced && !full)
+    {
+      ++dropped;
+      return false;
+    }
+    d.dist = dist;
+    d.tick = tick;
+    d.synced = true;
+
+    out.dist = dist;
+    out.tick = tick;
+    out.flux = 0;
+    out.temp = 0;
+    if( buf[ 0] & TFL_TLM_FLUX)
+    {
+      out.flux = ( int16_t)get16( buf + p);
+      p += 2;
+    }
+    if( buf[ 0] & TFL_TLM_TEMP) out.temp = ( int16_t)get16( buf + p);
+    out.addr = base + id;
+    out.status = tflStatus( status);
+    last = id;
+    return true;
+}
@@ -0,0 +1,187 @@
+/* File Name: TFLTelemetry.h
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Compact binary packets of TF-Luna frames, to stream
+ *            every frame of several devices over a serial link.
+ *
+ *  A frame printed as text costs about 30 bytes.  A packet costs five
+ *  bytes in the usual case, so 8 devices at 250 frames a second fit in
+ *  a 115200 baud link:
+ *    sync   0xA4 + fields: bit 0 flux follows, bit 1 temp follows
+ *    head   device id in bits 0 to 3, `TFLStatus` in bits 4 to 7.
+ *           0xF in bits 4 to 7 is followed by the status as a byte.
+ *    dist   change of distance from the last packet of the device,
+ *           int8.  0x80 is followed by the distance as int16.
+ *    tick   change of device tick, uint8.  0xFF is followed by the
+ *           tick as uint16.
+ *    flux   int16, if the fields ask for it
+ *    temp   int16, if the fields ask for it
+ *    crc    CRC-8 of every byte after the sync byte, see `tflCrc8`
+ *  Numbers of two bytes are sent low byte first.  The id of a device
+ *  is its address less the base address, modulo 16, so with the default
+ *  base `TFL_DEF_ADR` the addresses 0x10 to 0x1F are ids 0 to 15.
+ *
+ *  The first packet of a device, and then one in every `keyEvery`,
+ *  is a key packet that sends distance and tick in full.  After a bad
+ *  packet the decoder drops the changes of every device until that
+ *  device's next key packet, so a lost byte costs each device at most
+ *  `keyEvery` frames.
+ *
+ *  `drain()` takes frames from the head of a `TFLRing` with `peek()`,
+ *  packs each into a packet of at most `TFL_TLM_MAX` bytes and writes
+ *  it to the sink, straight into the transmit buffer of a serial port.
+ *  It stops before a packet that would not fit `availableForWrite()`,
+ *  so it never blocks and never drops a frame: a frame stays in the
+ *  ring until it is sent.
+ *
+ *  Typical use:
+ *    TFLRing< 64> ring;
+ *    TFLTelemetry tlm;
+ *    ...
+ *    tlm.drain( ring, Serial);          // in the main loop
+ *
+ *  and on the host:
+ *    TFLTelemetryDecoder dec;
+ *    if( dec.put( byte)) use( dec.frame());
+ */
+
+#ifndef TFLTELEMETRY_H
+#define TFLTELEMETRY_H
+
+#include <TFLI2C.h>
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//      Definitions
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#define TFL_TLM_SYNC      0xA4   // sync byte, low two bits are the fields
+#define TFL_TLM_FLUX      0x01   // fields: flux is sent
+#define TFL_TLM_TEMP      0x02   // fields: temperature is sent
+#define TFL_TLM_IDS         16   // device ids
+#define TFL_TLM_MAX         14   // longest packet
+#define TFL_TLM_KEY         32   // packets of a device between key packets
+#define TFL_TLM_DIST_ESC  0x80   // distance byte of a key packet
+#define TFL_TLM_TICK_ESC  0xFF   // tick byte of a key packet
+#define TFL_TLM_STAT_ESC  0x0F   // status bits of a status byte
+
+// The frame of an item kept in a ring.  Add an overload for
+// other item types to `drain()` rings of them.
+inline const TFLFrame &tflFrameOf( const TFLFrame &f) { return f;}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                 OBJECT CLASS DEFINITIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+class TFLTelemetry
+{
+  public:
+    TFLTelemetry( uint8_t fields = 0);
+
+    // `TFL_TLM_FLUX` and `TFL_TLM_TEMP` for the fields to send
+    void setFields( uint8_t fields);
+    // Address of device id 0
+    void setBase( uint8_t addr);
+    // Packets of a device between key packets, at least 1
+    void setKeyEvery( uint8_t n);
+    // Send a key packet next for every device
+    void reset();
+
+    // Pack `f` into `out`, at least `TFL_TLM_MAX` bytes.
+    // Returns the length of the packet.
+    uint8_t encode( const TFLFrame &f, uint8_t out[]);
+
+    // Send frames from `ring` to `sink` while the packets fit in
+    // `sink.availableForWrite()`, up to `max` frames.  Returns the
+    // number of frames sent.
+    template< typename Ring, typename Sink>
+    uint16_t drain( Ring &ring, Sink &sink, uint16_t max = 0xFFFF)
+    {
+        uint16_t n = 0;
+        uint8_t pkt[ TFL_TLM_MAX];
+        while( n < max)
+        {
+          int room = sink.availableForWrite();
+          if( room <= 0) break;
+          const typename Ring::Item *item = ring.peek();
+          if( !item) break;
+          const TFLFrame &f = tflFrameOf( *item);
+          Device &d = dev[ idOf( f.addr)];
+          Device next = d;
+          uint8_t len = pack( f, pkt, next);
+          if( room < len) break;        // the frame waits in the ring
+          sink.write( pkt, len);
+          ring.discard();
+          d = next;
+          ++frames;
+          bytes += len;
+          ++n;
+        }
+        return n;
+    }
+
+    uint32_t getFrames();    // frames packed
+    uint32_t getBytes();     // bytes packed
+
+  private:
+    struct Device
+    {
+        int16_t  dist;        // distance of the last packet
+        uint16_t tick;        // tick of the last packet
+        uint8_t  left;        // packets before the next key packet, 0 for now
+    };
+
+    uint8_t  fields;
+    uint8_t  base;
+    uint8_t  keyEvery;
+    uint32_t frames;
+    uint32_t bytes;
+    Device   dev[ TFL_TLM_IDS];
+
+    uint8_t idOf( uint8_t addr) { return ( uint8_t)( addr - base) & ( TFL_TLM_IDS - 1);}
+    uint8_t pack( const TFLFrame &f, uint8_t out[], Device &d);
+};
+
+class TFLTelemetryDecoder
+{
+  public:
+    TFLTelemetryDecoder();
+
+    // Address of device id 0
+    void setBase( uint8_t addr);
+    // Forget every device and any partial packet
+    void reset();
+
+    // Take the next byte of the stream.  Returns true when it
+    // completes a good packet, then found in `frame()`.
+    bool put( uint8_t b);
+    const TFLFrame &frame();
+    uint8_t id();            // device id of `frame()`
+
+    uint32_t getErrors();    // bad packets and runs of bytes between packets
+    uint32_t getDropped();   // packets lost waiting for a key packet
+
+  private:
+    struct Device
+    {
+        int16_t  dist;
+        uint16_t tick;
+        bool     synced;      // a key packet has been received
+    };
+
+    uint8_t  base;
+    uint8_t  buf[ TFL_TLM_MAX];
+    uint8_t  len;            // bytes of the packet so far
+    bool     skipping;       // bytes between packets are being skipped
+    uint8_t  last;           // id of `out`
+    TFLFrame out;
+    uint32_t errors;
+    uint32_t dropped;
+    Device   dev[ TFL_TLM_IDS];
+
+    uint8_t expected();
+    bool    unpack();
+    void    lost();
+};
+
+#endif  // TFLTELEMETRY_H
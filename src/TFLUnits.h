@@ -0,0 +1,95 @@
+/* File Name: TFLUnits.h
+ * Developer: Bud Ryerson
+ * Date:      14 OCT 2026
+ * Version:   0.3.0 - First version
+ * Described: Fixed-point unit conversions for the data values of the
+ *            Benewake TF-Luna Lidar sensor.
+ *
+ *  `getData` passes back distance in centimeters and temperature in
+ *  hundredths of a degree Celsius.  These functions convert them with
+ *  integer arithmetic only, rounded to the nearest unit, so that a
+ *  target without a floating point unit need not link soft-float.
+ *  They are `constexpr`, so a constant argument is converted at compile
+ *  time.  Fractional units are kept as hundredths, for example
+ *  `tflCmToIn100( 254)` is 10000, or 100.00 inches.
+ *
+ *  To pick the units once at configuration time, name them in a
+ *  `TFLUnits` type.  The choice is then made by the compiler and
+ *  costs nothing at run time:
+ *    typedef TFLUnits< TFL_UNIT_IN100, TFL_UNIT_F100> MyUnits;
+ *    ...
+ *    int32_t d = MyUnits::dist( tfDist);   // hundredths of an inch
+ *    int32_t t = MyUnits::temp( tfTemp);   // hundredths of a degree F
+ */
+
+#ifndef TFLUNITS_H
+#define TFLUNITS_H
+
+#include <TFLI2C.h>
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//      Definitions
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// Distance units
+#define TFL_UNIT_CM          0   // centimeters, as read
+#define TFL_UNIT_MM          1   // millimeters
+#define TFL_UNIT_IN100       2   // hundredths of an inch
+#define TFL_UNIT_FT100       3   // hundredths of a foot
+#define TFL_UNIT_IN          4   // whole inches
+#define TFL_UNIT_FT          5   // whole feet
+
+// Temperature units
+#define TFL_UNIT_C100        0   // hundredths of a degree Celsius, as read
+#define TFL_UNIT_F100        1   // hundredths of a degree Fahrenheit
+#define TFL_UNIT_C           2   // whole degrees Celsius
+#define TFL_UNIT_F           3   // whole degrees Fahrenheit
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                 CONVERSION FUNCTIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// Divide, rounding half away from zero
+constexpr int32_t tflDivRound( int32_t n, int32_t d)
+{
+    return( n >= 0) ? ( ( n + d / 2) / d) : -( ( -n + d / 2) / d);
+}
+
+// - - - -   Distance from centimeters   - - - -
+// One inch is 2.54cm and one foot is 30.48cm exactly.
+constexpr int32_t tflCmToMm( int16_t cm)    { return( int32_t)cm * 10;}
+constexpr int32_t tflCmToIn100( int16_t cm) { return tflDivRound( ( int32_t)cm * 10000, 254);}
+constexpr int32_t tflCmToFt100( int16_t cm) { return tflDivRound( ( int32_t)cm * 10000, 3048);}
+constexpr int32_t tflCmToIn( int16_t cm)    { return tflDivRound( ( int32_t)cm * 100, 254);}
+constexpr int32_t tflCmToFt( int16_t cm)    { return tflDivRound( ( int32_t)cm * 100, 3048);}
+
+// - - - -   Temperature from hundredths of a degree Celsius   - - - -
+constexpr int32_t tflC100ToF100( int16_t c100) { return tflDivRound( ( int32_t)c100 * 9, 5) + 3200;}
+constexpr int32_t tflC100ToC( int16_t c100)    { return tflDivRound( c100, 100);}
+constexpr int32_t tflC100ToF( int16_t c100)    { return tflDivRound( ( int32_t)c100 * 9 + 16000L, 500);}
+
+// - - - -   Units chosen at compile time   - - - -
+template< uint8_t DistUnit, uint8_t TempUnit = TFL_UNIT_C100>
+struct TFLUnits
+{
+    static_assert( DistUnit <= TFL_UNIT_FT, "Unknown TFLUnits distance unit");
+    static_assert( TempUnit <= TFL_UNIT_F, "Unknown TFLUnits temperature unit");
+
+    static constexpr int32_t dist( int16_t cm)
+    {
+        return( DistUnit == TFL_UNIT_MM)    ? tflCmToMm( cm) :
+              ( DistUnit == TFL_UNIT_IN100) ? tflCmToIn100( cm) :
+              ( DistUnit == TFL_UNIT_FT100) ? tflCmToFt100( cm) :
+              ( DistUnit == TFL_UNIT_IN)    ? tflCmToIn( cm) :
+              ( DistUnit == TFL_UNIT_FT)    ? tflCmToFt( cm) : cm;
+    }
+
+    static constexpr int32_t temp( int16_t c100)
+    {
+        return( TempUnit == TFL_UNIT_F100) ? tflC100ToF100( c100) :
+              ( TempUnit == TFL_UNIT_C)    ? tflC100ToC( c100) :
+              ( TempUnit == TFL_UNIT_F)    ? tflC100ToF( c100) : c100;
+    }
+};
+
+#endif  // TFLUNITS_H